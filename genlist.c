@@ -4,6 +4,11 @@
 #include <stdio.h>
 
 
+/*------------NODE POOL SLAB SIZES (in nodes)------------*/
+#define POOL_MIN_SLAB   64
+#define POOL_MAX_SLAB   4096
+
+
 
 /*------------INITIALIZE THE STRUCTURE SIZE VARIABLE (global)------------*/
 void export_structure(const size_t size)
@@ -24,10 +29,12 @@ void* xmalloc(const size_t size)
 {
     /*Allocating a memory block of given size.*/
     void *block = malloc(size);
+    STATS_GLOBAL(heap_allocations, 1);
 
     /*Checking whether the memory is actually allocated or not.
     If not, printing error messege and exit the program.*/
     if(!block) {
+        STATS_GLOBAL(allocation_failures, 1);
         puts("[Error]: xmalloc()\\ fatal error\\ out of memory.!");
         return (NULL); // return NULL: if no memory available.
     }
@@ -37,451 +44,1939 @@ void* xmalloc(const size_t size)
 
 
 
-/*------------CREATE ONE NODE------------*/
-node_t* create_node(void * data, const type_t type)
+/*------------ADD ONE SLAB OF NODES TO THE POOL------------*/
+static status_t pool_grow(pool_t *pool, len_t count)
 {
-    /*Creating new memory for the node using xmalloc().*/
-    node_t *newNode = (node_t*) xmalloc(sizeof(node_t));
-    if(!newNode)
-        return (NULL);
-
-    /*Setting data into the data section, datatype in the type section and NULL in the address section.*/
-    newNode->data = data;
-    newNode->type = type;
-    newNode->next = newNode->prev = newNode; // circular connection to a node.
-
-    return newNode;
-}
+    /* grow geometrically, so small lists stay small and big lists get big slabs. */
+    len_t step = pool->capacity < POOL_MAX_SLAB ? pool->capacity : POOL_MAX_SLAB;
+    if(step < POOL_MIN_SLAB)
+        step = POOL_MIN_SLAB;
+    if(count < step)
+        count = step;
+
+    struct Node_Slab *slab = pool_slab(pool, count);
+    if(!slab)
+        return (MEMORY_ERROR);
 
+    /* thread the new nodes on the free list, lowest address first. */
+    for(len_t i = count; i > 0; i--) {
+        slab->nodes[i - 1].next = pool->free_nodes;
+        pool->free_nodes = &slab->nodes[i - 1];
+    }
 
+    pool->available += count;
 
-/*------------CREATE LIST------------*/
-list_t* create_list(void)
-{
-    /*Create one node (head node) with null data, which will hold the entire list in its next pointer.
-    This node will never be changed, whatever the operation done to the list. (push, pop, etc)*/
-    return create_node(NULL, NULL_DATA);
+    return (SUCCESS);
 }
 
 
 
-/*------------CHECK IS LIST EMPTY ?------------*/
-bool_t isEmpty(const list_t *list)
+/*------------ADD ONE SLAB OF 'count' NODES TO THE POOL, LEFT OFF THE FREE LIST------------*/
+struct Node_Slab* pool_slab(pool_t *pool, const len_t count)
 {
-    /* If the list holds NULL, return true: list is empty. */
-    if(!list) 
-        return (true);
+    struct Node_Slab *slab = (struct Node_Slab*) xmalloc(sizeof(struct Node_Slab) + count * sizeof(node_t));
+    if(!slab)
+        return (NULL);
+
+    slab->count = count;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->capacity += count;
 
-    /* If dummy node is the only node exists, return true: list is empty. */
-    return (list->next == list && list->prev == list);
+    return (slab);
 }
 
 
 
-/*------------INSERT ONE NODE AT THE FRONT OF THE LIST------------*/
-status_t put_front(list_t *list, void * data, const type_t type)
+/*------------TAKE ONE NODE FROM THE POOL------------*/
+node_t* pool_alloc(pool_t *pool)
 {
-    node_t *newNode = create_node(data, type);
-    if(!newNode)
-        return (MEMORY_ERROR);
+    /* refill the free list with a new slab only when it runs dry. */
+    if(!pool->free_nodes && pool_grow(pool, 0) != SUCCESS)
+        return (NULL);
 
-    /* if list is not created, create one. */
-    if(!list)
-        list = create_list();
-    
-    /* insert the node at first position. */
-    generic_insert(list, newNode, list->next);
+    node_t *node = pool->free_nodes;
+    pool->free_nodes = node->next;
+    pool->available--;
+    PREFETCH_JUMP_CLEAR(node);
 
-    return (SUCCESS);
+    return (node);
 }
 
 
 
-/*------------INSERT ONE NODE AT THE END OF THE LIST------------*/
-status_t put_back(list_t *list, void * data, const type_t type)
+/*------------GIVE ONE NODE BACK TO THE POOL------------*/
+void pool_free(pool_t *pool, node_t *node)
 {
-    node_t *newNode = create_node(data, type);
-    if(!newNode)
-        return (MEMORY_ERROR);
-        
-
-    if(!list)
-        list = create_list();
-
-    generic_insert(list->prev, newNode, list);
-
-    return (SUCCESS);
+    /* push the node on the free list, its 'next' field is the link. */
+    node->next = pool->free_nodes;
+    pool->free_nodes = node;
+    pool->available++;
 }
 
 
 
-/*------------INSERT ONE NODE AFTER AN EXISTING NODE------------*/
-status_t put_after(list_t *list,
-    void * existing_data, const type_t existing_type,
-    void * new_data, const type_t new_type)
+/*------------MAKE SURE THE POOL HOLDS AT LEAST 'count' FREE NODES------------*/
+status_t pool_reserve(pool_t *pool, const len_t count)
 {
-    /* if list is empty, can't insert. */
-    if(isEmpty(list))
-        return (LIST_EMPTY);
-
-    /* search existing data node in the list. */
-    node_t *target_node = search_node(list, existing_data, existing_type);
-
-    /* if data not present in the list, notify that back. */
-    if(!target_node)
-        return (LIST_DATA_NOT_FOUND);
-    
-    /* create new node to insert after existing node. */
-    node_t *newNode = create_node(new_data, new_type);
-    if(!newNode)
-        return (MEMORY_ERROR);
-
-    /* simply insert new node at its position. */
-    generic_insert(target_node, newNode, target_node->next);
+    if(pool->available >= count)
+        return (SUCCESS);
 
-    return (SUCCESS);
+    return pool_grow(pool, count - pool->available);
 }
 
 
 
-/*------------INSERT ONE NODE BEFORE AN EXISTING NODE------------*/
-status_t put_before(list_t *list,
-    void * existing_date, const type_t existing_type,
-    void * new_data, const type_t new_type)
+/*------------DEALLOCATE EVERY SLAB AND PAYLOAD OF THE POOL------------*/
+void pool_release(pool_t *pool)
 {
-    if(isEmpty(list))
-        return (LIST_EMPTY);
-    
-    node_t *target_node = search_node(list, existing_date, existing_type);
-    if(!target_node)
-        return (LIST_DATA_NOT_FOUND);
+    struct Node_Slab *slab = pool->slabs;
 
-    node_t *newNode = create_node(new_data, new_type);
-    if(!newNode)
-        return (MEMORY_ERROR);
+    while(slab) {
+        struct Node_Slab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
 
-    generic_insert(target_node->prev, newNode, target_node);
+    pool->slabs = NULL;
+    pool->free_nodes = NULL;
+    pool->capacity = pool->available = 0;
 
-    return (SUCCESS);
+    pool_release_payloads(pool);
 }
 
 
 
-/*------------REMOVE ONE NODE FROM THE FRONT OF THE LIST------------*/
-status_t pop_front(list_t *list)
+/*------------DEALLOCATE THE PAYLOAD BLOCKS OF THE POOL, ONCE NO NODE IS IN USE------------*/
+/* payloads are only referenced by nodes of the pool: with every node free, none is left pointing to them. */
+void pool_release_payloads(pool_t *pool)
 {
-    /* if list is not created: can't delete. */
-    if(isEmpty(list))
-        return (LIST_EMPTY);
-
-    /* simply delete the 1st node.*/
-    generic_delete(list->next);
+    if(pool->available != pool->capacity)
+        return;
 
-    return (SUCCESS);
+    struct Payload_Block *payload = pool->payloads;
+    while(payload) {
+        struct Payload_Block *next = payload->next;
+        free(payload);
+        payload = next;
+    }
+    pool->payloads = NULL;
 }
 
 
 
-/*------------REMOVE ONE NODE FROM THE END OF THE LIST------------*/
-status_t pop_back(list_t *list)
+/*------------ORDER OF TWO SLABS BY ADDRESS (qsort)------------*/
+static int slab_order(const void *a, const void *b)
 {
-    if(isEmpty(list))
-        return (LIST_EMPTY);
+    long unsigned int x = (long unsigned int) *(struct Node_Slab* const*)a;
+    long unsigned int y = (long unsigned int) *(struct Node_Slab* const*)b;
 
-    generic_delete(list->prev);
-
-    return (SUCCESS);
+    return (x > y) - (x < y);
 }
 
 
 
-/*------------REMOVE ONE NODE AFTER AN EXISTING NODE------------*/
-status_t pop_after(list_t *list, const void *existing_data, const type_t existing_type)
+/*------------SLAB HOLDING A NODE, IN SLABS SORTED BY ADDRESS------------*/
+static len_t slab_of(struct Node_Slab **slabs, const len_t count, const node_t *node)
 {
-    if(isEmpty(list))
-        return (LIST_EMPTY);
+    len_t low = 0, high = count;
+
+    /* the last slab starting before the node. */
+    while(high - low > 1) {
+        len_t middle = low + (high - low) / 2;
+        if((long unsigned int)slabs[middle] < (long unsigned int)node)
+            low = middle;
+        else
+            high = middle;
+    }
 
-    node_t *target_node = search_node(list, existing_data, existing_type);
-    if(!target_node)
-        return (LIST_DATA_NOT_FOUND);
+    return (low);
+}
 
-    if(target_node->next == list)
-        return (FAILED);
 
-    generic_delete(target_node->next);
 
-    return (SUCCESS);
-}
+/*------------DEALLOCATE EVERY SLAB WHOSE NODES ARE ALL FREE (returns the nodes released)------------*/
+len_t pool_trim(pool_t *pool)
+{
+    len_t count = 0;
+    for(struct Node_Slab *slab = pool->slabs; slab; slab = slab->next)
+        count++;
+
+    if(!count || !pool->available)
+        return (0);
+
+    struct Node_Slab **slabs = (struct Node_Slab**) xmalloc(count * sizeof(struct Node_Slab*));
+    len_t *free_counts = (len_t*) calloc(count, sizeof(len_t));
+    if(!slabs || !free_counts) {
+        free(slabs);
+        free(free_counts);
+        return (0);
+    }
 
+    count = 0;
+    for(struct Node_Slab *slab = pool->slabs; slab; slab = slab->next)
+        slabs[count++] = slab;
+    qsort(slabs, count, sizeof(struct Node_Slab*), slab_order);
 
+    for(node_t *node = pool->free_nodes; node; node = node->next)
+        free_counts[slab_of(slabs, count, node)]++;
 
-/*------------REMOVE ONE NODE BEFORE AN EXISTING NODE------------*/
-status_t pop_before(list_t *list, const void *existing_data, const type_t existing_type)
-{
-    if(isEmpty(list))
-        return (LIST_EMPTY);
+    len_t released = 0;
+    for(len_t i = 0; i < count; i++) {
+        if(free_counts[i] == slabs[i]->count)
+            released += slabs[i]->count;
+    }
 
-    node_t *target_node = search_node(list, existing_data, existing_type);
-    if(!target_node)
-        return (LIST_DATA_NOT_FOUND);
+    /* the free nodes of the slabs still in use stay, in the same order (after a compaction: none). */
+    if(released == pool->available)
+        pool->free_nodes = NULL;
+    else if(released) {
+        node_t **link = &pool->free_nodes;
+        for(node_t *node = pool->free_nodes; node; node = node->next) {
+            len_t i = slab_of(slabs, count, node);
+            if(free_counts[i] != slabs[i]->count) {
+                *link = node;
+                link = &node->next;
+            }
+        }
+        *link = NULL;
+    }
 
-    if(target_node->prev == list)
-        return (FAILED);
+    struct Node_Slab **slab_link = &pool->slabs;
+    while(*slab_link) {
+        struct Node_Slab *slab = *slab_link;
+        if(free_counts[slab_of(slabs, count, slab->nodes)] == slab->count) {
+            *slab_link = slab->next;
+            free(slab);
+        }
+        else
+            slab_link = &slab->next;
+    }
 
-    generic_delete(target_node->prev);
+    pool->capacity -= released;
+    pool->available -= released;
 
-    return (SUCCESS);
+    free(slabs);
+    free(free_counts);
+
+    return (released);
 }
 
 
 
-/*------------REMOVE ONE DATA NODE FROM THE LIST------------*/
-status_t remove_data(list_t *list, const void * delete_data, const type_t delete_type)
+/*------------ALLOCATE 'size' BYTES OF NODE DATA, LIVING AS LONG AS THE POOL------------*/
+void* pool_payload(pool_t *pool, const len_t size)
 {
-    /* if list is not created: can't delete. */
-    if(isEmpty(list))
-        return (LIST_EMPTY);
+    struct Payload_Block *block = (struct Payload_Block*) xmalloc(sizeof(struct Payload_Block) + size);
+    if(!block)
+        return (NULL);
 
-    /* search the node containing data similar to the data want to delete. */
-    node_t *target_node = search_node(list, delete_data, delete_type);
-    if(!target_node)
-        return (LIST_DATA_NOT_FOUND);
+    block->next = pool->payloads;
+    pool->payloads = block;
 
-    /* simply delete the searched node from the list. */
-    generic_delete(target_node);
+    return (block->bytes);
 }
 
 
 
-/*------------FETCH THE FIRST NODE FROM THE LIST------------*/
-status_t get_front(const list_t *list, node_t **front_node)
+/*------------ALLOCATE ONE EMPTY POOL (with one reference)------------*/
+pool_t* create_pool(void)
 {
-    /* if list is empty: can't get 1st node. */
-    if(isEmpty(list))
-        return (LIST_EMPTY);
+    pool_t *pool = (pool_t*) xmalloc(sizeof(pool_t));
+    if(!pool)
+        return (NULL);
 
-    /* store 1st node data in the front_node. */
-    *front_node = create_node(list->next->data, list->next->type);
-    if(!(*front_node))
-        return (MEMORY_ERROR);
+    pool->free_nodes = NULL;
+    pool->slabs = NULL;
+    pool->payloads = NULL;
+    pool->capacity = pool->available = 0;
+    pool->references = 1;
+    pool->forward = NULL;
 
-    return (SUCCESS);
+    return (pool);
 }
 
 
 
-/*------------FETCH THE LAST NODE FROM THE LIST------------*/
-status_t get_back(const list_t *list, node_t **last_node)
+/*------------DROP ONE REFERENCE TO A POOL, DEALLOCATE IT WITH THE LAST ONE------------*/
+void pool_unref(pool_t *pool)
 {
-    if(isEmpty(list))
-        return (LIST_EMPTY);
+    if(--pool->references > 0)
+        return;
 
-    *last_node = create_node(list->prev->data, list->prev->type);
-    if(!(*last_node))
-        return (MEMORY_ERROR);
+    /* a merged pool only holds a reference to the pool which took its slabs. */
+    if(pool->forward)
+        pool_unref(pool->forward);
+    else
+        pool_release(pool);
 
-    return (SUCCESS);
+    free(pool);
 }
 
 
 
-/*------------FETCH THE NODE AFTER EXISTING NODE------------*/
-status_t get_after(const list_t *list,
-    const void *existing_data, const type_t existing_type,
-    node_t **target_node)
+/*------------MOVE ALL SLABS AND FREE NODES OF 'src' TO 'dst'------------*/
+void pool_merge(pool_t *dst, pool_t *src)
 {
-    /* If list is empty: notify calling statement. */
-    if(isEmpty(list))
-        return (LIST_EMPTY);
+    if(src->slabs) {
+        struct Node_Slab *slab = src->slabs;
+        while(slab->next)
+            slab = slab->next;
+        slab->next = dst->slabs;
+        dst->slabs = src->slabs;
+    }
 
-    /* search node with given data in list. */
-    node_t *existing_target_node = search_node(list, existing_data, existing_type);
-    if(!existing_target_node)
-        return (LIST_DATA_NOT_FOUND);
+    if(src->payloads) {
+        struct Payload_Block *payload = src->payloads;
+        while(payload->next)
+            payload = payload->next;
+        payload->next = dst->payloads;
+        dst->payloads = src->payloads;
+    }
 
-    /* If node is last node, notify calling. */
-    if(existing_target_node->next == list)
-        return (FAILED);
+    if(src->free_nodes) {
+        node_t *node = src->free_nodes;
+        while(node->next)
+            node = node->next;
+        node->next = dst->free_nodes;
+        dst->free_nodes = src->free_nodes;
+    }
 
-    /* Create new node with data to get with memory error handling. */
-    *target_node = create_node(
-        existing_target_node->next->data,
-        existing_target_node->next->type
-    );
-    if(!(*target_node))
-        return (MEMORY_ERROR);
+    dst->capacity += src->capacity;
+    dst->available += src->available;
 
-    return (SUCCESS);
+    /* lists still pointing to 'src' are redirected to 'dst' by list_pool(). */
+    src->slabs = NULL;
+    src->payloads = NULL;
+    src->free_nodes = NULL;
+    src->capacity = src->available = 0;
+    src->forward = dst;
+    dst->references++;
 }
 
 
 
-/*------------FETCH THE NODE BEFORE EXISTING NODE------------*/
-status_t get_before(const list_t *list,
-    const void *existing_data, const type_t existing_type,
-    node_t **target_node)
+/*------------POOL OF THE LIST (following merged pools)------------*/
+pool_t* list_pool(list_t *list)
 {
-    if(isEmpty(list))
-        return (LIST_EMPTY);
-
-    node_t *existing_target_node = search_node(list, existing_data, existing_type);
-    if(!existing_target_node)
-        return (LIST_DATA_NOT_FOUND);
+    pool_t *pool = list->pool;
+    if(!pool->forward)
+        return (pool);
 
-    if(existing_target_node->prev == list)
-        return (FAILED);
+    while(pool->forward)
+        pool = pool->forward;
 
-    *target_node = create_node(
-        existing_target_node->prev->data,
-        existing_target_node->prev->type
-    );
-    if(!(*target_node))
-        return (MEMORY_ERROR);
+    /* point the list straight at the pool which owns the slabs now. */
+    pool->references++;
+    pool_unref(list->pool);
+    list->pool = pool;
 
-    return (SUCCESS);
+    return (pool);
 }
 
 
 
-/*------------SHOW LIST NODES ONE BY ONE------------*/
-status_t show_list(const list_t *list, void (*struct_display)(void*))
+/*------------PRE-ALLOCATE NODES FOR THE UPCOMING INSERTIONS------------*/
+status_t reserve_list(list_t *list, const len_t count)
 {
-    if(isEmpty(list))
-        return (LIST_EMPTY);
-
-    /* Set 'current' at 1st node. */
-    node_t *current = list->next;
-
-    status_t status;
+    if(!list)
+        return (INVALID_DATA);
 
-    fprintf(stdout, "[START] <-> ");
-    /* Iterate till 'current' gets to end of list. */
-    while(current != list) {
+    if(list->backend == PACKED_LIST)
+        return packed_reserve(list, count);
 
-        /* call 'show_data()' to display node data. */
-        status = show_data(current, struct_display);
+    /* unrolled lists allocate blocks, not nodes. */
+    if(list->backend != LINKED_LIST)
+        return (LIST_UNSUPPORTED);
 
-        /* if 'show_data()' fails, notify calling. */
-        if(!(status == SUCCESS))
-            return (status);
+    return pool_reserve(list_pool(list), count);
+}
 
-        fprintf(stdout, " <-> ");
 
-        /* Increment 'current' to next address. */
-        current = current->next;
-    }
-    fprintf(stdout, "[END]\n");
 
-    return (SUCCESS);
+/*------------DEALLOCATE A NODE FETCHED BY get_*() (same as free())------------*/
+void release_node(node_t *node)
+{
+    free(node);
 }
 
 
 
-/*------------SHOW ONE NODE DATA------------*/
-status_t show_data(const node_t *data_node, void (*struct_display)(void*))
+/*------------CREATE ONE NODE------------*/
+node_t* create_node(void * data, const type_t type)
 {
-    /* Validate the given data. */
-    if(!data_node || !data_node->data)
-        return (INVALID_DATA);
-
-    /*
-    If the node data type is STRUCTURE,
-    then call the client display function using function pointer passed.
-    else, check the data type and print accordingly.
-    */
-    if(data_node->type == STRUCTURE) {
-        fprintf(stdout, "{");
-        struct_display(data_node->data);
-        fprintf(stdout, "}");
-    } else {
-        switch(data_node->type) {
-            case INTEGER:
-                fprintf(stdout, "[%d]", *(int*)data_node->data);
-                break;
-            case DOUBLE:
-                fprintf(stdout, "[%lf]", *(double*)data_node->data);
-                break;
-            case CHARACTER:
-                fprintf(stdout, "[%c]", *(char*)data_node->data);
-                break;
-            case STRING:
-                fprintf(stdout, "[%s]", (char*)data_node->data);
-                break;
+    /*Creating new memory for the node using xmalloc(): a node living outside any list belongs to
+    the caller, who may free() it from any thread.*/
+    node_t *newNode = (node_t*) xmalloc(sizeof(node_t));
+    if(!newNode)
+        return (NULL);
+    PREFETCH_JUMP_CLEAR(newNode);
 
-            /*
-            If node data type does not match with above types,
-            notify calling about invalid type.
-            */
-            default:
-                return (INVALID_TYPE);
-        }
-    }
-    
-    
+    /*Setting data into the data section, datatype in the type section and NULL in the address section.*/
+    newNode->data = data;
+    newNode->type = TYPE_BASE(type);
+    newNode->type_id = TYPE_ID(type);
+    newNode->storage = STORE_REFERENCE;
+    tag_node(newNode);
+    newNode->next = newNode->prev = newNode; // circular connection to a node.
 
-    return (SUCCESS);
+    return newNode;
 }
 
 
 
-/*------------SEARCH DATA IN THE LIST------------*/
-status_t contains_data(const list_t *list, const void * data, const type_t type)
+/*------------BYTES COPIED BY AN OWNING LIST FOR STRING / STRUCTURE DATA------------*/
+static len_t owned_size(const list_t *list, const void * data, const type_t type)
 {
-    if(isEmpty(list)) {
-        return (FALSE);
-    }
-    
-    /* if node with given data found in list, notify TRUE, else FALSE. */
-    return search_node(list, data, type) ? TRUE : FALSE;
-}
+    if(TYPE_BASE(type) == STRING)
+        return strlen((const char*)data) + 1;
 
+    const structure_type_t *info = structure_type(list, type);
+    if(info)
+        return (info->size);
 
+    return (list->structure_size ? list->structure_size : STRUCTURE_SIZE);
+}
 
-/*------------GET LIST NODES COUNT (length)------------*/
-len_t get_list_length(const list_t *list)
-{
-    if(isEmpty(list))
-        return 0;
-    
-    /* set 'current' to the 1st node. */
-    node_t *current = list->next;
 
-    /* set length to 0. */
-    len_t length = 0;
 
-    /* Iterate till 'current' reaches to end of list. */
-    while(current != list) {
+/*------------CREATE ONE NODE HOLDING A COPY OF THE DATA (owning lists)------------*/
+static node_t* create_owned_node(list_t *list, void * data, const type_t type)
+{
+    node_t *newNode;
+
+    switch(TYPE_BASE(type)) {
+        /* scalars are copied into the node itself: no allocation beyond the pool. */
+        case INTEGER:
+        case DOUBLE:
+        case CHARACTER:
+            newNode = pool_alloc(list_pool(list));
+            if(!newNode)
+                return (NULL);
+            newNode->double_value = 0;
+            if(TYPE_BASE(type) == INTEGER)
+                newNode->int_value = *(const int*)data;
+            else if(TYPE_BASE(type) == DOUBLE)
+                newNode->double_value = *(const double*)data;
+            else
+                newNode->char_value = *(const char*)data;
+            newNode->storage = STORE_INLINE;
+            break;
+
+        /* the copy goes right after the node: one allocation, and the data shares its cache lines. */
+        case STRING:
+        case STRUCTURE: {
+            len_t size = owned_size(list, data, type);
+            newNode = (node_t*) xmalloc(sizeof(node_t) + size);
+            if(!newNode)
+                return (NULL);
+            newNode->data = newNode + 1;
+            memcpy(newNode->data, data, size);
+            newNode->storage = STORE_OWNED;
+            PREFETCH_JUMP_CLEAR(newNode);
+            break;
+        }
 
-        /* Increment the length (node counter) by one in each iteration. */
-        length++;
-        current = current->next;
+        default:
+            return (NULL);
     }
+    STATS_COUNT(list, allocations, 1);
+
+    newNode->type = TYPE_BASE(type);
+    newNode->type_id = TYPE_ID(type);
+    tag_node(newNode);
+    newNode->next = newNode->prev = newNode;
 
-    return (length);
+    return newNode;
 }
 
 
 
-/*------------DEALLOCATE THE DYNAMIC MEMORY OF ALL NODES------------*/
-list_t* clear_list(list_t *list)
+/*------------GIVE THE MEMORY OF AN UNLINKED NODE BACK (pool, or heap for an owned copy)------------*/
+static void free_list_node(list_t *list, node_t *node)
 {
-    if(isEmpty(list))
+    if(node->storage == STORE_OWNED)
+        free(node);
+    else
+        pool_free(list_pool(list), node);
+}
+
+
+
+/*------------CREATE ONE NODE FROM THE LIST POOL------------*/
+node_t* create_list_node(list_t *list, void * data, const type_t type)
+{
+    if(list->owns_data && data)
+        return create_owned_node(list, data, type);
+
+    node_t *newNode = pool_alloc(list_pool(list));
+    if(!newNode)
+        return (NULL);
+    STATS_COUNT(list, allocations, 1);
+
+    newNode->data = data;
+    newNode->type = TYPE_BASE(type);
+    newNode->type_id = TYPE_ID(type);
+    newNode->storage = STORE_REFERENCE;
+    tag_node(newNode);
+    newNode->next = newNode->prev = newNode;
+
+    return newNode;
+}
+
+
+
+/*------------COPY ONE NODE (data reference or inline value)------------*/
+node_t* copy_node(const node_t *node)
+{
+    node_t *newNode = create_node(node->data, node_type(node));
+    if(!newNode)
+        return (NULL);
+
+    /* the union copy above also carries an inline value, keep its storage mode.
+    an owned copy stays with the list node: the fetched node only refers to it. */
+    newNode->double_value = node->double_value;
+    newNode->storage = (node->storage == STORE_OWNED) ? STORE_REFERENCE : node->storage;
+
+    return newNode;
+}
+
+
+
+/*------------ADDRESS OF THE DATA HELD BY A NODE------------*/
+const void* node_data(const node_t *node)
+{
+    /* inline values live in the node itself. */
+    return (node->storage == STORE_INLINE) ? (const void*)&node->data : node->data;
+}
+
+
+
+/*------------DATA TYPE OF A NODE (with its registered STRUCTURE type id)------------*/
+type_t node_type(const node_t *node)
+{
+    return (type_t)(node->type | (node->type_id << TYPE_ID_SHIFT));
+}
+
+
+
+/*------------ONE-BYTE TAG OF A STRING (FNV-1a, top byte)------------*/
+unsigned char string_tag(const char *string)
+{
+    unsigned int hash = 2166136261U;
+
+    while(*string) {
+        hash ^= (unsigned char)*string++;
+        hash *= 16777619U;
+    }
+
+    return (unsigned char)(hash >> 24);
+}
+
+
+
+/*------------SET THE HASH TAG OF A NODE FROM ITS DATA (0 for all but STRING data)------------*/
+/* a referenced string must not change while it is in a list: its tag would no longer match. */
+void tag_node(node_t *node)
+{
+    node->hash_tag = (node->type == STRING && node->storage != STORE_INLINE && node->data) ?
+        string_tag((const char*)node->data) : 0;
+}
+
+
+
+/*------------CREATE AN EMPTY LIST DESCRIPTOR TAKING NODES FROM 'pool'------------*/
+static list_t* create_descriptor(const backend_t backend, pool_t *pool)
+{
+    list_t *list = (list_t*) xmalloc(sizeof(list_t));
+    if(!list)
+        return (NULL);
+
+    list->pool = pool;
+
+    /*The head node holds null data and the entire list in its next pointer.
+    This node will never be changed, whatever the operation done to the list. (push, pop, etc)*/
+    list->head.data = NULL;
+    list->head.type = NULL_DATA;
+    list->head.storage = STORE_REFERENCE;
+    list->head.type_id = 0;
+    list->head.hash_tag = 0;                    // read as the tag of the 'next' of the last node.
+    list->head.next = list->head.prev = &list->head;
+    PREFETCH_JUMP_CLEAR(&list->head);
+
+    list->backend = backend;
+    list->first_block = list->last_block = NULL;
+    list->packed = NULL;
+
+    list->length = 0;
+    list->structure_size = 0;
+    list->compare = NULL;
+    list->index = NULL;
+    list->order = NULL;
+    list->owns_data = false;
+    list->compaction = NULL;
+    list->stats.inserts = list->stats.removals = list->stats.peak_length = 0;
+    list->types = NULL;
+    list->type_count = 0;
+
+    return (list);
+}
+
+
+
+/*------------CREATE LIST------------*/
+list_t* create_list(void)
+{
+    return create_list_as(LINKED_LIST);
+}
+
+
+
+/*------------CREATE LIST WITH THE GIVEN BACKEND------------*/
+list_t* create_list_as(const backend_t backend)
+{
+    if(backend != LINKED_LIST && backend != UNROLLED_LIST && backend != PACKED_LIST)
+        return (NULL);
+
+    /* every list gets its own node pool, so destroying the list returns whole slabs. */
+    pool_t *pool = create_pool();
+    if(!pool)
+        return (NULL);
+
+    list_t *list = create_descriptor(backend, pool);
+    if(!list)
+        pool_unref(pool);
+
+    return (list);
+}
+
+
+
+/*------------SET THE STRUCTURE SIZE AND COMPARATOR OF ONE LIST------------*/
+status_t set_list_structure(list_t *list, const size_t size, compare_t compare)
+{
+    if(!list)
+        return (INVALID_DATA);
+
+    /* size 0 keeps using the global STRUCTURE_SIZE. */
+    list->structure_size = size;
+    list->compare = compare;
+
+    /* STRUCTURE hashes depend on these settings: rebuild the index. */
+    if(list->index) {
+        disable_index(list);
+        return enable_index(list);
+    }
+
+    return (SUCCESS);
+}
+
+
+
+/*------------MAKE THE LIST COPY THE DATA OF EVERY INSERTION (or refer to it again)------------*/
+status_t set_list_owned(list_t *list, const bool_t owned)
+{
+    if(!list)
+        return (INVALID_DATA);
+
+    /* unrolled elements have no node to carry the copy. */
+    if(list->backend != LINKED_LIST)
+        return (LIST_UNSUPPORTED);
+
+    /* nodes inserted before keep their own storage mode. */
+    list->owns_data = owned;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------REGISTER ONE STRUCTURE TYPE ON THE LIST (returns its type, NULL_DATA on error)------------*/
+type_t register_structure(list_t *list, const size_t size, compare_t compare, hasher_t hash, display_t display)
+{
+    /* unrolled elements keep one tag byte: no room for a type id. */
+    if(!list || !size || list->backend != LINKED_LIST || list->type_count == MAX_STRUCTURE_TYPES)
+        return (NULL_DATA);
+
+    structure_type_t *types = (structure_type_t*) realloc(list->types, (list->type_count + 1) * sizeof(structure_type_t));
+    if(!types)
+        return (NULL_DATA);
+
+    list->types = types;
+    types[list->type_count].size = size;
+    types[list->type_count].compare = compare;
+    types[list->type_count].hash = hash;
+    types[list->type_count].display = display;
+    list->type_count++;
+
+    /* the type id rides above the base type: STRUCTURE | id << TYPE_ID_SHIFT. */
+    return (type_t)(STRUCTURE | (list->type_count << TYPE_ID_SHIFT));
+}
+
+
+
+/*------------REGISTERED STRUCTURE TYPE (NULL: not a registered type)------------*/
+const structure_type_t* structure_type(const list_t *list, const type_t type)
+{
+    unsigned int id = TYPE_ID(type);
+
+    if(TYPE_BASE(type) != STRUCTURE || id == 0 || id > list->type_count)
+        return (NULL);
+
+    return (&list->types[id - 1]);
+}
+
+
+
+/*------------ALL 8 BYTES OF A VALUE CLEARED------------*/
+static value_t empty_value(void)
+{
+    value_t value;
+    memset(&value, 0, sizeof(value));
+    return (value);
+}
+
+
+
+/*------------VALUE HOLDING AN INTEGER / A DOUBLE------------*/
+static value_t int_value(const int data)
+{
+    value_t value = empty_value();
+    value.int_value = data;
+    return (value);
+}
+
+static value_t double_value(const double data)
+{
+    value_t value = empty_value();
+    value.double_value = data;
+    return (value);
+}
+
+
+
+/*------------VALUE HOLDING A DATA REFERENCE------------*/
+static value_t reference_value(void * data)
+{
+    value_t value = empty_value();
+    value.data = data;
+    return (value);
+}
+
+
+
+/*------------CHECK IS LIST EMPTY ?------------*/
+bool_t isEmpty(const list_t *list)
+{
+    /* If the list holds NULL, return true: list is empty. */
+    if(!list) 
+        return (true);
+
+    /* If no data node is counted, return true: list is empty. */
+    return (list->length == 0);
+}
+
+
+
+/*------------INSERT ONE NODE AT THE FRONT OF THE LIST------------*/
+status_t put_front(list_t *list, void * data, const type_t type)
+{
+    STATS_LATENCY(STAT_PUT_FRONT);
+
+    /* if list is not created, create one. */
+    if(!list)
+        list = create_list();
+    if(!list)
+        return (MEMORY_ERROR);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_put_front(list, reference_value(data), (unsigned char)type);
+    if(list->backend == PACKED_LIST)
+        return packed_put_front(list, reference_value(data), (unsigned char)type);
+
+    node_t *newNode = create_list_node(list, data, type);
+    if(!newNode)
+        return (MEMORY_ERROR);
+    
+    /* insert the node at first position. */
+    generic_insert(list, &list->head, newNode, list->head.next);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------INSERT ONE NODE AT THE END OF THE LIST------------*/
+status_t put_back(list_t *list, void * data, const type_t type)
+{
+    STATS_LATENCY(STAT_PUT_BACK);
+
+    if(!list)
+        list = create_list();
+    if(!list)
+        return (MEMORY_ERROR);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_put_back(list, reference_value(data), (unsigned char)type);
+    if(list->backend == PACKED_LIST)
+        return packed_put_back(list, reference_value(data), (unsigned char)type);
+
+    node_t *newNode = create_list_node(list, data, type);
+    if(!newNode)
+        return (MEMORY_ERROR);
+
+    generic_insert(list, list->head.prev, newNode, &list->head);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------INSERT ONE NODE AFTER AN EXISTING NODE------------*/
+status_t put_after(list_t *list,
+    void * existing_data, const type_t existing_type,
+    void * new_data, const type_t new_type)
+{
+    STATS_LATENCY(STAT_PUT_AFTER);
+
+    /* if list is empty, can't insert. */
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_put_after(list, existing_data, existing_type, reference_value(new_data), (unsigned char)new_type);
+    if(list->backend == PACKED_LIST)
+        return packed_put_after(list, existing_data, existing_type, reference_value(new_data), (unsigned char)new_type);
+
+    /* search existing data node in the list. */
+    node_t *target_node = search_node(list, existing_data, existing_type);
+
+    /* if data not present in the list, notify that back. */
+    if(!target_node)
+        return (LIST_DATA_NOT_FOUND);
+    
+    /* create new node to insert after existing node. */
+    node_t *newNode = create_list_node(list, new_data, new_type);
+    if(!newNode)
+        return (MEMORY_ERROR);
+
+    /* simply insert new node at its position. */
+    generic_insert(list, target_node, newNode, target_node->next);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------INSERT ONE NODE BEFORE AN EXISTING NODE------------*/
+status_t put_before(list_t *list,
+    void * existing_date, const type_t existing_type,
+    void * new_data, const type_t new_type)
+{
+    STATS_LATENCY(STAT_PUT_BEFORE);
+
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_put_before(list, existing_date, existing_type, reference_value(new_data), (unsigned char)new_type);
+    if(list->backend == PACKED_LIST)
+        return packed_put_before(list, existing_date, existing_type, reference_value(new_data), (unsigned char)new_type);
+    
+    node_t *target_node = search_node(list, existing_date, existing_type);
+    if(!target_node)
+        return (LIST_DATA_NOT_FOUND);
+
+    node_t *newNode = create_list_node(list, new_data, new_type);
+    if(!newNode)
+        return (MEMORY_ERROR);
+
+    generic_insert(list, target_node->prev, newNode, target_node);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------INSERT ONE VALUE (held inline) AT THE FRONT OR AT THE END------------*/
+static status_t put_value(list_t *list, const value_t value, const type_t type, const bool_t front)
+{
+    STATS_LATENCY(STAT_PUT_VALUE);
+
+    if(!list)
+        return (INVALID_DATA);
+
+    if(list->backend == UNROLLED_LIST) {
+        if(front)
+            return unrolled_put_front(list, value, (unsigned char)type | UNROLLED_INLINE);
+        return unrolled_put_back(list, value, (unsigned char)type | UNROLLED_INLINE);
+    }
+    if(list->backend == PACKED_LIST) {
+        if(front)
+            return packed_put_front(list, value, (unsigned char)type | UNROLLED_INLINE);
+        return packed_put_back(list, value, (unsigned char)type | UNROLLED_INLINE);
+    }
+
+    node_t *newNode = create_list_node(list, NULL, type);
+    if(!newNode)
+        return (MEMORY_ERROR);
+
+    /* the value is written over the data reference. */
+    newNode->double_value = value.double_value;
+    newNode->storage = STORE_INLINE;
+
+    if(front)
+        generic_insert(list, &list->head, newNode, list->head.next);
+    else
+        generic_insert(list, list->head.prev, newNode, &list->head);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------INSERT ONE INTEGER VALUE AT THE FRONT / END OF THE LIST------------*/
+status_t put_front_int(list_t *list, const int value)
+{
+    return put_value(list, int_value(value), INTEGER, true);
+}
+
+status_t put_back_int(list_t *list, const int value)
+{
+    return put_value(list, int_value(value), INTEGER, false);
+}
+
+
+
+/*------------INSERT ONE DOUBLE VALUE AT THE FRONT / END OF THE LIST------------*/
+status_t put_front_double(list_t *list, const double value)
+{
+    return put_value(list, double_value(value), DOUBLE, true);
+}
+
+status_t put_back_double(list_t *list, const double value)
+{
+    return put_value(list, double_value(value), DOUBLE, false);
+}
+
+
+
+/*------------INSERT ONE CHARACTER VALUE AT THE FRONT / END OF THE LIST------------*/
+status_t put_front_char(list_t *list, const char value)
+{
+    value_t element = empty_value();
+    element.char_value = value;
+    return put_value(list, element, CHARACTER, true);
+}
+
+status_t put_back_char(list_t *list, const char value)
+{
+    value_t element = empty_value();
+    element.char_value = value;
+    return put_value(list, element, CHARACTER, false);
+}
+
+
+
+/*------------VALUE AND TAG OF THE ELEMENT 'i' OF A BULK INSERTION------------*/
+static value_t bulk_value(void **data, const int *ints, const double *doubles, const len_t i)
+{
+    if(data)
+        return reference_value(data[i]);
+
+    return ints ? int_value(ints[i]) : double_value(doubles[i]);
+}
+
+static unsigned char bulk_tag(const type_t *types, const int *ints, const len_t i)
+{
+    if(types)
+        return (unsigned char)types[i];
+
+    return (unsigned char)(ints ? INTEGER : DOUBLE) | UNROLLED_INLINE;
+}
+
+
+
+/*------------INSERT 'count' ELEMENTS AT THE FRONT OR AT THE END, IN ARRAY ORDER------------*/
+/* elements come from 'data' + 'types' (referenced), or from 'ints' / 'doubles' (held inline). */
+static status_t put_bulk(list_t *list, void **data, const type_t *types,
+    const int *ints, const double *doubles, const len_t count, const bool_t front)
+{
+    STATS_LATENCY(STAT_PUT_BULK);
+
+    if(!list || (!data && !ints && !doubles) || (data && !types))
+        return (INVALID_DATA);
+
+    if(count == 0)
+        return (SUCCESS);
+
+    /* blocks are filled one element at a time. at the front, go backward to keep the array order. */
+    if(list->backend == UNROLLED_LIST) {
+        status_t status = SUCCESS;
+        for(len_t i = 0; i < count && status == SUCCESS; i++) {
+            if(front)
+                status = unrolled_put_front(list, bulk_value(data, ints, doubles, count - 1 - i), bulk_tag(types, ints, count - 1 - i));
+            else
+                status = unrolled_put_back(list, bulk_value(data, ints, doubles, i), bulk_tag(types, ints, i));
+        }
+        return (status);
+    }
+
+    /* packed nodes are reserved at once, then taken one by one. */
+    if(list->backend == PACKED_LIST) {
+        status_t status = packed_reserve(list, count);
+        for(len_t i = 0; i < count && status == SUCCESS; i++) {
+            if(front)
+                status = packed_put_front(list, bulk_value(data, ints, doubles, count - 1 - i), bulk_tag(types, ints, count - 1 - i));
+            else
+                status = packed_put_back(list, bulk_value(data, ints, doubles, i), bulk_tag(types, ints, i));
+        }
+        return (status);
+    }
+
+    /* an owning list copies every element in its own node, still linked as one chain. */
+    if(data && list->owns_data) {
+        node_t *first = NULL, *last = NULL;
+        for(len_t i = 0; i < count; i++) {
+            node_t *newNode = create_owned_node(list, data[i], types[i]);
+            if(!newNode) {
+                for(node_t *current = first, *next; current; current = next) {
+                    next = (current == last) ? NULL : current->next;
+                    free_list_node(list, current);
+                }
+                return (MEMORY_ERROR);
+            }
+
+            newNode->prev = last;
+            if(last)
+                last->next = newNode;
+            else
+                first = newNode;
+            last = newNode;
+        }
+
+        if(front)
+            generic_insert_chain(list, &list->head, first, last, list->head.next, count);
+        else
+            generic_insert_chain(list, list->head.prev, first, last, &list->head, count);
+
+        return (SUCCESS);
+    }
+
+    /* one slab for the nodes the free list lacks, if any. */
+    pool_t *pool = list_pool(list);
+    if(pool_reserve(pool, count) != SUCCESS)
+        return (MEMORY_ERROR);
+
+    /* fill and chain the nodes, then link the whole chain at once. */
+    node_t *first = NULL, *last = NULL;
+    for(len_t i = 0; i < count; i++) {
+        node_t *newNode = pool_alloc(pool);
+        value_t value = bulk_value(data, ints, doubles, i);
+
+        newNode->double_value = value.double_value;
+        newNode->type = (type_t)(bulk_tag(types, ints, i) & ~UNROLLED_INLINE);
+        newNode->type_id = types ? TYPE_ID(types[i]) : 0;
+        newNode->storage = data ? STORE_REFERENCE : STORE_INLINE;
+        tag_node(newNode);
+
+        newNode->prev = last;
+        if(last)
+            last->next = newNode;
+        else
+            first = newNode;
+        last = newNode;
+    }
+    STATS_COUNT(list, allocations, count);
+
+    if(front)
+        generic_insert_chain(list, &list->head, first, last, list->head.next, count);
+    else
+        generic_insert_chain(list, list->head.prev, first, last, &list->head, count);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------INSERT AN ARRAY OF DATA AT THE FRONT / END OF THE LIST------------*/
+status_t put_front_bulk(list_t *list, void **data, const type_t *types, const len_t count)
+{
+    return put_bulk(list, data, types, NULL, NULL, count, true);
+}
+
+status_t put_back_bulk(list_t *list, void **data, const type_t *types, const len_t count)
+{
+    return put_bulk(list, data, types, NULL, NULL, count, false);
+}
+
+
+
+/*------------INSERT AN ARRAY OF INTEGER VALUES AT THE FRONT / END OF THE LIST------------*/
+status_t put_front_ints(list_t *list, const int *values, const len_t count)
+{
+    return put_bulk(list, NULL, NULL, values, NULL, count, true);
+}
+
+status_t put_back_ints(list_t *list, const int *values, const len_t count)
+{
+    return put_bulk(list, NULL, NULL, values, NULL, count, false);
+}
+
+
+
+/*------------INSERT AN ARRAY OF DOUBLE VALUES AT THE FRONT / END OF THE LIST------------*/
+status_t put_front_doubles(list_t *list, const double *values, const len_t count)
+{
+    return put_bulk(list, NULL, NULL, NULL, values, count, true);
+}
+
+status_t put_back_doubles(list_t *list, const double *values, const len_t count)
+{
+    return put_bulk(list, NULL, NULL, NULL, values, count, false);
+}
+
+
+
+/*------------REMOVE ONE NODE FROM THE FRONT OF THE LIST------------*/
+status_t pop_front(list_t *list)
+{
+    STATS_LATENCY(STAT_POP_FRONT);
+
+    /* if list is not created: can't delete. */
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_pop_front(list);
+    if(list->backend == PACKED_LIST)
+        return packed_pop_front(list);
+
+    /* simply delete the 1st node.*/
+    generic_delete(list, list->head.next);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------REMOVE ONE NODE FROM THE END OF THE LIST------------*/
+status_t pop_back(list_t *list)
+{
+    STATS_LATENCY(STAT_POP_BACK);
+
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_pop_back(list);
+    if(list->backend == PACKED_LIST)
+        return packed_pop_back(list);
+
+    generic_delete(list, list->head.prev);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------REMOVE ONE NODE AFTER AN EXISTING NODE------------*/
+status_t pop_after(list_t *list, const void *existing_data, const type_t existing_type)
+{
+    STATS_LATENCY(STAT_POP_AFTER);
+
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_pop_after(list, existing_data, existing_type);
+    if(list->backend == PACKED_LIST)
+        return packed_pop_after(list, existing_data, existing_type);
+
+    node_t *target_node = search_node(list, existing_data, existing_type);
+    if(!target_node)
+        return (LIST_DATA_NOT_FOUND);
+
+    if(target_node->next == &list->head)
+        return (FAILED);
+
+    generic_delete(list, target_node->next);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------REMOVE ONE NODE BEFORE AN EXISTING NODE------------*/
+status_t pop_before(list_t *list, const void *existing_data, const type_t existing_type)
+{
+    STATS_LATENCY(STAT_POP_BEFORE);
+
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_pop_before(list, existing_data, existing_type);
+    if(list->backend == PACKED_LIST)
+        return packed_pop_before(list, existing_data, existing_type);
+
+    node_t *target_node = search_node(list, existing_data, existing_type);
+    if(!target_node)
+        return (LIST_DATA_NOT_FOUND);
+
+    if(target_node->prev == &list->head)
+        return (FAILED);
+
+    generic_delete(list, target_node->prev);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------REMOVE ONE DATA NODE FROM THE LIST------------*/
+status_t remove_data(list_t *list, const void * delete_data, const type_t delete_type)
+{
+    STATS_LATENCY(STAT_REMOVE_DATA);
+
+    /* if list is not created: can't delete. */
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_remove_data(list, delete_data, delete_type);
+    if(list->backend == PACKED_LIST)
+        return packed_remove_data(list, delete_data, delete_type);
+
+    /* search the node containing data similar to the data want to delete. */
+    node_t *target_node = search_node(list, delete_data, delete_type);
+    if(!target_node)
+        return (LIST_DATA_NOT_FOUND);
+
+    /* simply delete the searched node from the list. */
+    generic_delete(list, target_node);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------FETCH THE FIRST NODE FROM THE LIST------------*/
+status_t get_front(const list_t *list, node_t **front_node)
+{
+    STATS_LATENCY(STAT_GET);
+
+    /* if list is empty: can't get 1st node. */
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_get_front(list, front_node);
+    if(list->backend == PACKED_LIST)
+        return packed_get_front(list, front_node);
+
+    /* store 1st node data in the front_node. */
+    *front_node = copy_node(list->head.next);
+    if(!(*front_node))
+        return (MEMORY_ERROR);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------FETCH THE LAST NODE FROM THE LIST------------*/
+status_t get_back(const list_t *list, node_t **last_node)
+{
+    STATS_LATENCY(STAT_GET);
+
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_get_back(list, last_node);
+    if(list->backend == PACKED_LIST)
+        return packed_get_back(list, last_node);
+
+    *last_node = copy_node(list->head.prev);
+    if(!(*last_node))
+        return (MEMORY_ERROR);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------FETCH THE NODE AFTER EXISTING NODE------------*/
+status_t get_after(const list_t *list,
+    const void *existing_data, const type_t existing_type,
+    node_t **target_node)
+{
+    STATS_LATENCY(STAT_GET);
+
+    /* If list is empty: notify calling statement. */
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_get_after(list, existing_data, existing_type, target_node);
+    if(list->backend == PACKED_LIST)
+        return packed_get_after(list, existing_data, existing_type, target_node);
+
+    /* search node with given data in list. */
+    node_t *existing_target_node = search_node(list, existing_data, existing_type);
+    if(!existing_target_node)
+        return (LIST_DATA_NOT_FOUND);
+
+    /* If node is last node, notify calling. */
+    if(existing_target_node->next == &list->head)
+        return (FAILED);
+
+    /* Create new node with data to get with memory error handling. */
+    *target_node = copy_node(existing_target_node->next);
+    if(!(*target_node))
+        return (MEMORY_ERROR);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------FETCH THE NODE BEFORE EXISTING NODE------------*/
+status_t get_before(const list_t *list,
+    const void *existing_data, const type_t existing_type,
+    node_t **target_node)
+{
+    STATS_LATENCY(STAT_GET);
+
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_get_before(list, existing_data, existing_type, target_node);
+    if(list->backend == PACKED_LIST)
+        return packed_get_before(list, existing_data, existing_type, target_node);
+
+    node_t *existing_target_node = search_node(list, existing_data, existing_type);
+    if(!existing_target_node)
+        return (LIST_DATA_NOT_FOUND);
+
+    if(existing_target_node->prev == &list->head)
+        return (FAILED);
+
+    *target_node = copy_node(existing_target_node->prev);
+    if(!(*target_node))
+        return (MEMORY_ERROR);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------VIEW ONE NODE (no allocation)------------*/
+static status_t view_node(const node_t *node, view_t *view)
+{
+    view->data = node_data(node);
+    view->type = node_type(node);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------VIEW THE FIRST NODE OF THE LIST------------*/
+status_t peek_front(const list_t *list, view_t *view)
+{
+    STATS_LATENCY(STAT_PEEK);
+
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_peek_front(list, view);
+    if(list->backend == PACKED_LIST)
+        return packed_peek_front(list, view);
+
+    return view_node(list->head.next, view);
+}
+
+
+
+/*------------VIEW THE LAST NODE OF THE LIST------------*/
+status_t peek_back(const list_t *list, view_t *view)
+{
+    STATS_LATENCY(STAT_PEEK);
+
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_peek_back(list, view);
+    if(list->backend == PACKED_LIST)
+        return packed_peek_back(list, view);
+
+    return view_node(list->head.prev, view);
+}
+
+
+
+/*------------VIEW THE NODE AFTER EXISTING NODE------------*/
+status_t peek_after(const list_t *list,
+    const void *existing_data, const type_t existing_type,
+    view_t *view)
+{
+    STATS_LATENCY(STAT_PEEK);
+
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_peek_after(list, existing_data, existing_type, view);
+    if(list->backend == PACKED_LIST)
+        return packed_peek_after(list, existing_data, existing_type, view);
+
+    node_t *existing_target_node = search_node(list, existing_data, existing_type);
+    if(!existing_target_node)
+        return (LIST_DATA_NOT_FOUND);
+
+    if(existing_target_node->next == &list->head)
+        return (FAILED);
+
+    return view_node(existing_target_node->next, view);
+}
+
+
+
+/*------------VIEW THE NODE BEFORE EXISTING NODE------------*/
+status_t peek_before(const list_t *list,
+    const void *existing_data, const type_t existing_type,
+    view_t *view)
+{
+    STATS_LATENCY(STAT_PEEK);
+
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_peek_before(list, existing_data, existing_type, view);
+    if(list->backend == PACKED_LIST)
+        return packed_peek_before(list, existing_data, existing_type, view);
+
+    node_t *existing_target_node = search_node(list, existing_data, existing_type);
+    if(!existing_target_node)
+        return (LIST_DATA_NOT_FOUND);
+
+    if(existing_target_node->prev == &list->head)
+        return (FAILED);
+
+    return view_node(existing_target_node->prev, view);
+}
+
+
+
+/*------------SEARCH DATA IN THE LIST------------*/
+status_t contains_data(const list_t *list, const void * data, const type_t type)
+{
+    STATS_LATENCY(STAT_CONTAINS_DATA);
+
+    if(isEmpty(list)) {
+        return (FALSE);
+    }
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_contains(list, data, type) ? TRUE : FALSE;
+    if(list->backend == PACKED_LIST)
+        return packed_contains(list, data, type) ? TRUE : FALSE;
+    
+    /* if node with given data found in list, notify TRUE, else FALSE. */
+    return search_node(list, data, type) ? TRUE : FALSE;
+}
+
+
+
+/*------------GET LIST NODES COUNT (length)------------*/
+len_t get_list_length(const list_t *list)
+{
+    if(!list)
+        return 0;
+
+    /* the node counter is kept up to date by generic_insert() and generic_delete(). */
+    return (list->length);
+}
+
+
+
+/*------------PLACE A CURSOR ON THE FIRST NODE------------*/
+status_t cursor_begin(list_t *list, list_cursor_t *cursor)
+{
+    if(!list || !cursor)
+        return (INVALID_DATA);
+
+    /* cursors walk nodes: linked lists only. */
+    if(list->backend != LINKED_LIST)
+        return (LIST_UNSUPPORTED);
+
+    cursor->list = list;
+    cursor->node = list->head.next;     // the head node itself if the list is empty.
+
+    return (SUCCESS);
+}
+
+
+
+/*------------PLACE A CURSOR AT THE END (on the head node, past the last node)------------*/
+status_t cursor_end(list_t *list, list_cursor_t *cursor)
+{
+    if(!list || !cursor)
+        return (INVALID_DATA);
+
+    if(list->backend != LINKED_LIST)
+        return (LIST_UNSUPPORTED);
+
+    cursor->list = list;
+    cursor->node = &list->head;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------IS THE CURSOR AT THE END ?------------*/
+bool_t cursor_at_end(const list_cursor_t *cursor)
+{
+    return (cursor->node == &cursor->list->head);
+}
+
+
+
+/*------------MOVE THE CURSOR ONE NODE FORWARD / BACKWARD------------*/
+/* the list is a ring: next of the last node and prev of the first node is the end. */
+void cursor_next(list_cursor_t *cursor)
+{
+    cursor->node = cursor->node->next;
+}
+
+void cursor_prev(list_cursor_t *cursor)
+{
+    cursor->node = cursor->node->prev;
+}
+
+
+
+/*------------VIEW THE NODE UNDER THE CURSOR------------*/
+status_t cursor_get(const list_cursor_t *cursor, view_t *view)
+{
+    if(cursor_at_end(cursor))
+        return (FAILED);
+
+    return view_node(cursor->node, view);
+}
+
+
+
+/*------------INSERT ONE NODE BEFORE THE CURSOR (at the end: put_back)------------*/
+status_t cursor_insert_before(list_cursor_t *cursor, void * data, const type_t type)
+{
+    node_t *newNode = create_list_node(cursor->list, data, type);
+    if(!newNode)
+        return (MEMORY_ERROR);
+
+    generic_insert(cursor->list, cursor->node->prev, newNode, cursor->node);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------INSERT ONE NODE AFTER THE CURSOR (at the end: put_front)------------*/
+status_t cursor_insert_after(list_cursor_t *cursor, void * data, const type_t type)
+{
+    node_t *newNode = create_list_node(cursor->list, data, type);
+    if(!newNode)
+        return (MEMORY_ERROR);
+
+    generic_insert(cursor->list, cursor->node, newNode, cursor->node->next);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------DELETE THE NODE UNDER THE CURSOR, AND MOVE TO THE NEXT ONE------------*/
+status_t cursor_erase(list_cursor_t *cursor)
+{
+    if(cursor_at_end(cursor))
+        return (FAILED);
+
+    node_t *target_node = cursor->node;
+    cursor->node = target_node->next;
+
+    generic_delete(cursor->list, target_node);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------SHARE ONE NODE POOL BETWEEN TWO LISTS (before moving nodes)------------*/
+static void share_pool(list_t *dst, list_t *src)
+{
+    pool_t *dst_pool = list_pool(dst);
+    pool_t *src_pool = list_pool(src);
+
+    /* moved nodes must be released to, and live as long as, the pool of their new list. */
+    if(dst_pool != src_pool) {
+        pool_merge(dst_pool, src_pool);
+        list_pool(src);
+    }
+}
+
+
+
+/*------------CAN NODES OF 'src' MOVE TO 'dst' ? (same registered type ids)------------*/
+static bool_t types_compatible(const list_t *dst, const list_t *src)
+{
+    if(src->type_count > dst->type_count)
+        return (false);
+
+    for(unsigned int i = 0; i < src->type_count; i++) {
+        const structure_type_t *a = &dst->types[i], *b = &src->types[i];
+        if(a->size != b->size || a->compare != b->compare || a->hash != b->hash || a->display != b->display)
+            return (false);
+    }
+
+    return (true);
+}
+
+
+
+/*------------UNCOUNT THE NODES first .. last FROM THE LIST (before unlinking them)------------*/
+static void forget_chain(list_t *list, node_t *first_node, node_t *last_node, const len_t count)
+{
+    if(list->index) {
+        for(node_t *current = first_node; ; current = current->next) {
+            index_remove(list, current);
+            if(current == last_node)
+                break;
+        }
+    }
+
+    list->length -= count;
+    list->stats.removals += count;
+    STATS_GLOBAL(removals, count);
+}
+
+
+
+/*------------MOVE ALL NODES OF 'src' BEFORE 'position' OF 'dst' (NULL: at the end)------------*/
+status_t list_splice(list_t *dst, node_t *position, list_t *src)
+{
+    if(!dst || !src || dst == src)
+        return (INVALID_DATA);
+
+    if(dst->backend != src->backend)
+        return (LIST_UNSUPPORTED);
+
+    if(isEmpty(src))
+        return (SUCCESS);
+
+    /* unrolled lists have no nodes: only whole block chains are appended. */
+    if(dst->backend == UNROLLED_LIST) {
+        if(position)
+            return (LIST_UNSUPPORTED);
+        unrolled_concat(dst, src);
+        return (SUCCESS);
+    }
+
+    /* packed indices belong to one list: the elements are copied over. */
+    if(dst->backend == PACKED_LIST) {
+        if(position)
+            return (LIST_UNSUPPORTED);
+        return packed_concat(dst, src);
+    }
+
+    if(!position)
+        position = &dst->head;
+
+    if(!types_compatible(dst, src))
+        return (LIST_UNSUPPORTED);
+
+    /* the nodes of 'src' leave it: so does its compaction. */
+    compact_stop(src);
+    share_pool(dst, src);
+
+    node_t *first_node = src->head.next;
+    node_t *last_node = src->head.prev;
+    len_t count = src->length;
+
+    /* 'src' becomes empty. */
+    if(src->order)
+        order_clear(src);
+    forget_chain(src, first_node, last_node, count);
+    src->head.next = src->head.prev = &src->head;
+
+    generic_insert_chain(dst, position->prev, first_node, last_node, position, count);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------APPEND ALL NODES OF 'b' TO 'a' (b becomes empty)------------*/
+status_t list_concat(list_t *a, list_t *b)
+{
+    return list_splice(a, NULL, b);
+}
+
+
+
+/*------------NUMBER OF NODES FROM 'node' TO THE LAST ONE------------*/
+static len_t count_from(const list_t *list, const node_t *node)
+{
+    const node_t *forward = node;
+    const node_t *backward = node->prev;
+    len_t ahead = 0, behind = 0;
+
+    /* walk both ways at once: costs the length of the shorter side only. */
+    while(true) {
+        if(forward == &list->head)
+            return (ahead);
+        if(backward == &list->head)
+            return (list->length - behind);
+
+        ahead++;
+        forward = forward->next;
+        behind++;
+        backward = backward->prev;
+    }
+}
+
+
+
+/*------------MOVE 'node' AND ALL NODES AFTER IT TO A NEW LIST------------*/
+list_t* list_split_at(list_t *list, node_t *node)
+{
+    if(!list || !node || node == &list->head || list->backend != LINKED_LIST)
+        return (NULL);
+
+    /* the new list takes its nodes from the same pool, and a compaction would follow nodes into it. */
+    compact_stop(list);
+    pool_t *pool = list_pool(list);
+    list_t *part = create_descriptor(list->backend, pool);
+    if(!part)
+        return (NULL);
+    pool->references++;
+
+    part->structure_size = list->structure_size;
+    part->compare = list->compare;
+    part->owns_data = list->owns_data;
+
+    /* moved nodes keep their type ids: the part gets the same registry. */
+    if(list->type_count) {
+        part->types = (structure_type_t*) xmalloc(list->type_count * sizeof(structure_type_t));
+        if(!part->types) {
+            pool_unref(pool);
+            free(part);
+            return (NULL);
+        }
+        memcpy(part->types, list->types, list->type_count * sizeof(structure_type_t));
+        part->type_count = list->type_count;
+    }
+
+    node_t *last_node = list->head.prev;
+    len_t count = count_from(list, node);
+
+    /* both parts of an ordered list stay in order: their towers are built again. */
+    bool_t ordered = (list->order != NULL);
+    disable_order(list);
+
+    forget_chain(list, node, last_node, count);
+    node->prev->next = &list->head;
+    list->head.prev = node->prev;
+
+    generic_insert_chain(part, &part->head, node, last_node, &part->head, count);
+
+    /* an indexed list gives an indexed part, an ordered list ordered parts. */
+    if(list->index)
+        enable_index(part);
+    if(ordered) {
+        enable_order(list);
+        enable_order(part);
+    }
+
+    return (part);
+}
+
+
+
+/*------------MERGE SORT A NULL TERMINATED CHAIN OF NODES (next pointers only)------------*/
+static node_t* sort_chain(const list_t *list, node_t *chain, compare_t compare)
+{
+    /* bottom-up: merge runs of 1, 2, 4 ... nodes until one merge covers the chain. */
+    for(len_t width = 1; ; width *= 2) {
+        node_t *left = chain, *tail = NULL;
+        len_t merges = 0;
+        chain = NULL;
+
+        while(left) {
+            merges++;
+
+            node_t *right = left;
+            len_t left_size = 0, right_size = width;
+            while(right && left_size < width) {
+                right = right->next;
+                left_size++;
+            }
+
+            /* ties take the left node first: the sort is stable. */
+            while(left_size > 0 || (right_size > 0 && right)) {
+                node_t *next;
+                if(left_size == 0) {
+                    next = right;
+                    right = right->next;
+                    right_size--;
+                } else if(right_size == 0 || !right || compare_nodes(list, left, right, compare) <= 0) {
+                    next = left;
+                    left = left->next;
+                    left_size--;
+                } else {
+                    next = right;
+                    right = right->next;
+                    right_size--;
+                }
+
+                if(tail)
+                    tail->next = next;
+                else
+                    chain = next;
+                tail = next;
+            }
+
+            left = right;
+        }
+
+        tail->next = NULL;
+        if(merges <= 1)
+            return (chain);
+    }
+}
+
+
+
+/*------------SORT THE LIST IN PLACE (stable, relinks the nodes)------------*/
+status_t sort_list(list_t *list, compare_t compare)
+{
+    STATS_LATENCY(STAT_SORT_LIST);
+
+    if(!list)
+        return (INVALID_DATA);
+
+    if(list->backend != LINKED_LIST)
+        return (LIST_UNSUPPORTED);
+
+    /* an ordered list is sorted already, by its own rules only. */
+    if(list->order)
+        return compare ? LIST_UNSUPPORTED : SUCCESS;
+
+    if(list->length < 2)
+        return (SUCCESS);
+
+    /* the nodes change places: a compaction would no longer follow the list order. */
+    compact_stop(list);
+
+    /* open the ring, sort through the next pointers, then rebuild prev pointers and the ring. */
+    list->head.prev->next = NULL;
+    node_t *chain = sort_chain(list, list->head.next, compare);
+
+    node_t *previous = &list->head;
+    for(node_t *current = chain; current; current = current->next) {
+        previous->next = current;
+        current->prev = previous;
+        previous = current;
+    }
+    previous->next = &list->head;
+    list->head.prev = previous;
+
+    /* the old jumps point all over the list now. */
+    list_set_jumps(list);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------POINT EVERY NODE GENLIST_PREFETCH_DISTANCE NODES AHEAD (built with GENLIST_JUMP)------------*/
+status_t list_set_jumps(list_t *list)
+{
+    if(!list)
+        return (INVALID_DATA);
+
+    if(list->backend != LINKED_LIST)
+        return (LIST_UNSUPPORTED);
+
+#if defined(GENLIST_JUMP) && GENLIST_PREFETCH_DISTANCE > 0
+    /* 'ahead' runs GENLIST_PREFETCH_DISTANCE nodes in front: the last nodes of the list jump to the head. */
+    node_t *ahead = list->head.next;
+    for(unsigned int i = 0; i < GENLIST_PREFETCH_DISTANCE && ahead != &list->head; i++)
+        ahead = ahead->next;
+
+    for(node_t *current = list->head.next; current != &list->head; current = current->next) {
+        current->jump = ahead;
+        if(ahead != &list->head)
+            ahead = ahead->next;
+    }
+
+    return (SUCCESS);
+#else
+    return (LIST_UNSUPPORTED);
+#endif
+}
+
+
+
+/*------------DEALLOCATE THE DYNAMIC MEMORY OF ALL NODES------------*/
+list_t* clear_list(list_t *list)
+{
+    STATS_LATENCY(STAT_CLEAR_LIST);
+
+    if(isEmpty(list))
+        return (list);
+
+    if(list->backend == UNROLLED_LIST) {
+        unrolled_clear(list);
+        return (list);
+    }
+    if(list->backend == PACKED_LIST) {
+        packed_clear(list);
         return (list);
+    }
+
+    /* every node goes: drop the towers at once, not one by one. */
+    if(list->order)
+        order_clear(list);
+    compact_stop(list);
 
     /* set 'current' to the 1st node. */
-    node_t *current = list->next;
+    node_t *current = list->head.next;
+
+    while(current != &list->head) {
 
-    while(current != list) {
+        /* fetch the nodes ahead while this one is unlinked. */
+        PREFETCH_AHEAD(current);
 
         /* delete the 'current' node address. */
-        generic_delete(current);
+        generic_delete(list, current);
 
         /* reset the 'current' to the 1st node. */
-        current = list->next;
+        current = list->head.next;
     }
 
     /* reseting the list linking. */
-    list->next = list->prev = list;
+    list->head.next = list->head.prev = &list->head;
+    list->length = 0;
+
+    /* the data of a loaded list goes with its last node (lists sharing the pool may still use it). */
+    pool_release_payloads(list_pool(list));
     return (list);
 }
 
@@ -498,7 +1993,16 @@ list_t* destroy_list(list_t *list)
         list = clear_list(list);
     }
 
-    /* deallocate the dummy node. */
+    /* an emptied packed list may still hold its nodes. */
+    if(list->backend == PACKED_LIST)
+        packed_clear(list);
+
+    /* deallocate the hash index, the skip list, the node slabs and the list descriptor. */
+    compact_stop(list);
+    disable_index(list);
+    disable_order(list);
+    pool_unref(list->pool);
+    free(list->types);
     free(list);
 
     return (NULL);
@@ -507,8 +2011,14 @@ list_t* destroy_list(list_t *list)
 
 
 /*------------INSERTS NODE BETWEEN START AND END NODES------------*/
-void generic_insert(node_t *start_node, node_t *mid_node, node_t *end_node)
+void generic_insert(list_t *list, node_t *start_node, node_t *mid_node, node_t *end_node)
 {
+    /* an ordered list puts the node at its sorted place, whatever place was asked for. */
+    order_tower_t *update[ORDER_MAX_LEVEL];
+    if(list->order) {
+        start_node = order_position(list, mid_node, update);
+        end_node = start_node->next;
+    }
 
     /*
     insert the 'mid_node' in between the 'start_node' and 'end_node'.
@@ -518,88 +2028,500 @@ void generic_insert(node_t *start_node, node_t *mid_node, node_t *end_node)
     mid_node->prev = start_node;
     mid_node->next = end_node;
     end_node->prev = mid_node;
+
+    /* keep the hash index and the skip list in sync. */
+    if(list->index)
+        index_insert(list, mid_node);
+    if(list->order)
+        order_link(list, mid_node, update);
+
+    /* keep the node counter and the statistics up to date. */
+    list->length++;
+    list->stats.inserts++;
+    STATS_GLOBAL(inserts, 1);
+    if(list->length > list->stats.peak_length)
+        list->stats.peak_length = list->length;
+}
+
+
+
+/*------------INSERTS A CHAIN OF 'count' NODES (first .. last) BETWEEN START AND END NODES------------*/
+void generic_insert_chain(list_t *list, node_t *start_node, node_t *first_node, node_t *last_node,
+    node_t *end_node, const len_t count)
+{
+    /* an ordered list takes the nodes one by one, each at its sorted place. */
+    if(list->order) {
+        last_node->next = NULL;
+        for(node_t *current = first_node, *next; current; current = next) {
+            next = current->next;
+            generic_insert(list, NULL, current, NULL);
+        }
+        return;
+    }
+
+    /* four links, whatever the length of the chain. */
+    start_node->next = first_node;
+    first_node->prev = start_node;
+    last_node->next = end_node;
+    end_node->prev = last_node;
+
+    /* keep the hash index in sync. */
+    if(list->index) {
+        for(node_t *current = first_node; current != end_node; current = current->next)
+            index_insert(list, current);
+    }
+
+    list->length += count;
+    list->stats.inserts += count;
+    STATS_GLOBAL(inserts, count);
+    if(list->length > list->stats.peak_length)
+        list->stats.peak_length = list->length;
 }
 
 
 
 /*------------DELETES NODE------------*/
-void generic_delete(node_t *mid_node)
+void generic_delete(list_t *list, node_t *mid_node)
 {
 
+    /* keep the hash index and the skip list in sync. */
+    if(list->index)
+        index_remove(list, mid_node);
+    if(list->order)
+        order_remove(list, mid_node);
+
+    /* a compaction in progress goes on with the next node. */
+    if(list->compaction && list->compaction->next == mid_node)
+        list->compaction->next = mid_node->next;
+
     /* break the linking of list from 'mid_node'. */
     mid_node->prev->next = mid_node->next;
     mid_node->next->prev = mid_node->prev;
 
-    /* deallocate the 'mid_node' memory. and set pointer to 'NULL'. */
-    free(mid_node);
+    list->length--;
+    list->stats.removals++;
+    STATS_GLOBAL(removals, 1);
+    STATS_COUNT(list, frees, 1);
+
+    /* give the 'mid_node' memory back to the list pool (an owned copy goes with it). and set pointer to 'NULL'. */
+    free_list_node(list, mid_node);
     mid_node = NULL;
 }
 
 
 
-/*------------DEALLOCATE THE DYNAMIC MEMORY OF ALL NODES------------*/
+/*------------COMPARE THE DATA OF ONE NODE WITH THE GIVEN DATA------------*/
+bool_t match_data(const list_t *list, const node_t *node, const void * data, const type_t type)
+{
+    if(node->type != TYPE_BASE(type) || node->type_id != TYPE_ID(type))
+        return (false);
+
+    /* inline values are compared straight from the node. */
+    if(node->storage == STORE_INLINE) {
+        switch(type) {
+            case INTEGER:
+                return (node->int_value == *(const int*)data);
+            case DOUBLE:
+                return (memcmp(&node->double_value, data, sizeof(double)) == 0);
+            case CHARACTER:
+                return (node->char_value == *(const char*)data);
+            default:
+                return (false);
+        }
+    }
+
+    const structure_type_t *info;
+
+    switch(node->type) {
+        case INTEGER:
+            return (memcmp(node->data, data, sizeof(int)) == 0);
+        case DOUBLE:
+            return (memcmp(node->data, data, sizeof(double)) == 0);
+        case CHARACTER:
+            return (memcmp(node->data, data, sizeof(char)) == 0);
+        case STRING:
+            // compare string contents, up to the terminating '\0'.
+            return (strcmp((const char*)node->data, (const char*)data) == 0);
+        case STRUCTURE:
+            // registered types compare field-wise, or over their own size.
+            info = structure_type(list, type);
+            if(info) {
+                if(info->compare)
+                    return (info->compare(node->data, data) == 0);
+                return (memcmp(node->data, data, info->size) == 0);
+            }
+            // use the list comparator, else compare structure memory block value byte-by-byte.
+            if(list->compare)
+                return (list->compare(node->data, data) == 0);
+            return (memcmp(node->data, data, list->structure_size ? list->structure_size : STRUCTURE_SIZE) == 0);
+        default:
+            return (false);
+    }
+}
+
+
+
+/*------------ORDER OF TWO NODES (<0, 0, >0): BY TYPE FIRST, THEN BY VALUE------------*/
+int compare_nodes(const list_t *list, const node_t *a, const node_t *b, compare_t compare)
+{
+    // mixed lists: INTEGER < DOUBLE < CHARACTER < STRING < STRUCTURE, in enumeration order.
+    if(a->type != b->type)
+        return (a->type < b->type) ? -1 : 1;
+    // registered STRUCTURE types follow the default one, in registration order.
+    if(a->type_id != b->type_id)
+        return (a->type_id < b->type_id) ? -1 : 1;
+
+    const void *x = node_data(a);
+    const void *y = node_data(b);
+    const structure_type_t *info;
+
+    switch(a->type) {
+        case INTEGER: {
+            int i = *(const int*)x, j = *(const int*)y;
+            return (i > j) - (i < j);
+        }
+        case DOUBLE: {
+            double d = *(const double*)x, e = *(const double*)y;
+            // NaN has no order: keep all of them after the numbers.
+            if(d != d || e != e)
+                return (d != d) - (e != e);
+            return (d > e) - (d < e);
+        }
+        case CHARACTER:
+            return (*(const char*)x > *(const char*)y) - (*(const char*)x < *(const char*)y);
+        case STRING:
+            return strcmp((const char*)x, (const char*)y);
+        case STRUCTURE:
+            // the caller comparator, else the list one, else structure memory block byte-by-byte.
+            if(compare)
+                return compare(x, y);
+            info = structure_type(list, node_type(a));
+            if(info)
+                return info->compare ? info->compare(x, y) : memcmp(x, y, info->size);
+            if(list->compare)
+                return list->compare(x, y);
+            return memcmp(x, y, list->structure_size ? list->structure_size : STRUCTURE_SIZE);
+        default:
+            return (0);
+    }
+}
+
+
+
+/*------------SEARCH THE NODE HOLDING THE GIVEN DATA------------*/
 node_t* search_node(const list_t *list, const void * data, const type_t type)
 {
-    if(isEmpty(list))
+    /* unrolled lists have no nodes to point to: use contains_data(). */
+    if(isEmpty(list) || list->backend != LINKED_LIST)
         return (NULL);
+
+    /* only the types below can be searched. */
+    if(TYPE_BASE(type) < INTEGER || TYPE_BASE(type) > STRUCTURE)
+        return (NULL);
+
+    STATS_COUNT(list, searches, 1);
+
+    /* if the list keeps a hash index for this type, ask the index. */
+    if(list->index && index_covers(list, type))
+        return index_find(list, data, type);
+
+    /* an ordered list is searched through its skip list. */
+    if(list->order)
+        return order_find(list, data, type);
     
+    /* a string is compared only with nodes holding the same tag: most are passed over
+    without reading their string. */
+    bool_t tagged = (TYPE_BASE(type) == STRING);
+    unsigned char tag = tagged ? string_tag((const char*)data) : 0;
+
     /* set 'current' to 1st nnode. */
-    node_t *current = list->next;
+    node_t *current = list->head.next;
+    len_t visited = 0, comparisons = 0;
+    
+    while(current != &list->head) {
+        /* ask for the nodes ahead, and for the string of the next node if it may be compared. */
+        PREFETCH_AHEAD(current);
+        if(!tagged || current->next->hash_tag == tag)
+            PREFETCH_DATA(current->next);
+
+        visited++;
+        if(!tagged || current->hash_tag == tag) {
+            comparisons++;
+            if(match_data(list, current, data, type))
+                break;
+        }
 
-    /* 'str' to hold the string data. */
-    char * str = NULL;
+        current = current->next;
+    }
 
-    /* 'string_size' represents the length of string, to instruct the 'memcmp()'. */
-    size_t string_size;
-    
-    while(current != list) {
-        if(current->type == type) {
-            switch(type) {
-                case INTEGER:
-
-                    if(memcmp(current->data, data, sizeof(int)) == 0) {
-                        return (current);
-                    }
-                
-                    break;
-                case DOUBLE:
-                
-                    if(memcmp(current->data, data, sizeof(double)) == 0) {
-                        return (current);
-                    }
-                    
-                    break;
-                case CHARACTER:
-                    
-                    if(memcmp(current->data, data, sizeof(char)) == 0) {
-                        return (current);
-                    }
-                    
-                    break;
-                case STRING:
-
-                    str = (char*)current->data;
-                    string_size = strlen(str);
-                
-                    if(memcmp(current->data, str, string_size) == 0) {
-                        return (current);
-                    }
-                
-                    break;
-                case STRUCTURE:
-                
-                    // compare structure memory block value byte-by-byte.
-                    if(memcmp(current->data, data, STRUCTURE_SIZE) == 0) {
-                        return (current);
-                    }
-
-                    break;
-                default:
-                    return (NULL);
+    STATS_COUNT(list, visited, visited);
+    STATS_COUNT(list, comparisons, comparisons);
+
+    return (current != &list->head) ? current : NULL;
+}
+
+
+
+/*------------HASH INDEX: MINIMUM NUMBER OF SLOTS (power of 2)------------*/
+#define INDEX_MIN_SLOTS 64
+
+
+
+/*------------HASH INDEX: CAN THE INDEX HOLD DATA OF THIS TYPE ?------------*/
+bool_t index_covers(const list_t *list, const type_t type)
+{
+    const structure_type_t *info = structure_type(list, type);
+    if(info)
+        // registered types are hashed with their own hash, or byte-wise when compared byte-wise.
+        return (info->hash != NULL || info->compare == NULL);
+
+    switch(type) {
+        case INTEGER:
+        case DOUBLE:
+        case CHARACTER:
+        case STRING:
+            return (true);
+        case STRUCTURE:
+            // a custom comparator may call different bytes equal: such structures can't be hashed.
+            return (list->compare == NULL);
+        default:
+            return (false);
+    }
+}
+
+
+
+/*------------HASH INDEX: HASH THE TYPE AND THE VALUE BYTES (FNV-1a)------------*/
+hash_t hash_data(const list_t *list, const void * data, const type_t type)
+{
+    const unsigned char *bytes = (const unsigned char*) data;
+    size_t size;
+
+    const structure_type_t *info = structure_type(list, type);
+    if(info && info->hash)
+        return (info->hash(data) ^ ((hash_t)type * 1099511628211ULL));
+
+    switch(type) {
+        case INTEGER:   size = sizeof(int);     break;
+        case DOUBLE:    size = sizeof(double);  break;
+        case CHARACTER: size = sizeof(char);    break;
+        case STRING:    size = strlen((const char*)data); break;
+        default:        size = info ? info->size : (list->structure_size ? list->structure_size : STRUCTURE_SIZE); break;
+    }
+
+    hash_t hash = 14695981039346656037ULL ^ (hash_t)type;
+    for(size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return (hash);
+}
+
+
+
+/*------------HASH INDEX: PUT ONE SLOT IN THE TABLE (no growing)------------*/
+static void index_place(list_index_t *index, const hash_t hash, node_t *node)
+{
+    len_t mask = index->capacity - 1;
+    len_t i = (len_t)hash & mask;
+
+    /* linear probing till an empty slot. */
+    while(index->slots[i].node)
+        i = (i + 1) & mask;
+
+    index->slots[i].hash = hash;
+    index->slots[i].node = node;
+    index->count++;
+}
+
+
+
+/*------------HASH INDEX: DOUBLE THE TABLE------------*/
+static status_t index_grow(list_index_t *index)
+{
+    len_t old_capacity = index->capacity;
+    index_slot_t *old_slots = index->slots;
+
+    index_slot_t *slots = (index_slot_t*) calloc(old_capacity * 2, sizeof(index_slot_t));
+    if(!slots)
+        return (MEMORY_ERROR);
+
+    index->slots = slots;
+    index->capacity = old_capacity * 2;
+    index->count = 0;
+
+    for(len_t i = 0; i < old_capacity; i++) {
+        if(old_slots[i].node)
+            index_place(index, old_slots[i].hash, old_slots[i].node);
+    }
+
+    free(old_slots);
+    return (SUCCESS);
+}
+
+
+
+/*------------HASH INDEX: ADD ONE NODE------------*/
+void index_insert(list_t *list, node_t *node)
+{
+    if(!index_covers(list, node_type(node)))
+        return;
+
+    /* keep the table at most half full. */
+    if((list->index->count + 1) * 2 > list->index->capacity) {
+        /* out of memory: drop the index, searches fall back to the list scan. */
+        if(index_grow(list->index) != SUCCESS) {
+            disable_index(list);
+            return;
+        }
+    }
+
+    index_place(list->index, hash_data(list, node_data(node), node_type(node)), node);
+}
+
+
+
+/*------------HASH INDEX: REMOVE ONE NODE------------*/
+void index_remove(list_t *list, node_t *node)
+{
+    if(!index_covers(list, node_type(node)))
+        return;
+
+    list_index_t *index = list->index;
+    len_t mask = index->capacity - 1;
+    len_t i = (len_t)hash_data(list, node_data(node), node_type(node)) & mask;
+
+    /* find the slot of this very node. */
+    while(index->slots[i].node != node) {
+        if(!index->slots[i].node)
+            return;
+        i = (i + 1) & mask;
+    }
+
+    /* backward shift deletion: pull up the following slots, so probing never meets a hole. */
+    len_t hole = i;
+    for(len_t j = (i + 1) & mask; index->slots[j].node; j = (j + 1) & mask) {
+        len_t home = (len_t)index->slots[j].hash & mask;
+
+        /* the slot may move to the hole only if its home is not between the hole and itself. */
+        if(((j - home) & mask) >= ((j - hole) & mask)) {
+            index->slots[hole] = index->slots[j];
+            hole = j;
+        }
+    }
+
+    index->slots[hole].node = NULL;
+    index->count--;
+}
+
+
+
+/*------------HASH INDEX: THE NODE MOVED TO ANOTHER ADDRESS (same data)------------*/
+void index_move(list_t *list, node_t *node, node_t *moved)
+{
+    if(!index_covers(list, node_type(node)))
+        return;
+
+    list_index_t *index = list->index;
+    len_t mask = index->capacity - 1;
+
+    for(len_t i = (len_t)hash_data(list, node_data(node), node_type(node)) & mask; index->slots[i].node; i = (i + 1) & mask) {
+        if(index->slots[i].node == node) {
+            index->slots[i].node = moved;
+            return;
+        }
+    }
+}
+
+
+
+/*------------HASH INDEX: FIND THE FIRST NODE HOLDING THE GIVEN DATA------------*/
+node_t* index_find(const list_t *list, const void * data, const type_t type)
+{
+    list_index_t *index = list->index;
+    hash_t hash = hash_data(list, data, type);
+    len_t mask = index->capacity - 1;
+    node_t *found = NULL;
+
+    for(len_t i = (len_t)hash & mask; index->slots[i].node; i = (i + 1) & mask) {
+        STATS_COUNT(list, visited, 1);
+        if(index->slots[i].hash == hash) {
+            STATS_COUNT(list, comparisons, 1);
+            if(!match_data(list, index->slots[i].node, data, type))
+                continue;
+            if(!found) {
+                found = index->slots[i].node;
+                continue;
+            }
+
+            /* duplicates: the probe order is not the list order, so the list tells which comes first. */
+            for(node_t *current = list->head.next; current != &list->head; current = current->next) {
+                STATS_COUNT(list, visited, 1);
+                if(match_data(list, current, data, type))
+                    return (current);
             }
         }
-        current = current->next;
     }
 
-    return (NULL);
-}
\ No newline at end of file
+    return (found);
+}
+
+
+
+/*------------BUILD THE HASH INDEX OF THE LIST------------*/
+status_t enable_index(list_t *list)
+{
+    if(!list)
+        return (INVALID_DATA);
+
+    /* the index maps values to nodes: linked lists only. */
+    if(list->backend != LINKED_LIST)
+        return (LIST_UNSUPPORTED);
+
+    if(list->index)
+        return (SUCCESS);
+
+    /* size the table for the current list, at most half full. */
+    len_t capacity = INDEX_MIN_SLOTS;
+    while(capacity < list->length * 2)
+        capacity *= 2;
+
+    list_index_t *index = (list_index_t*) xmalloc(sizeof(list_index_t));
+    if(!index)
+        return (MEMORY_ERROR);
+
+    index->slots = (index_slot_t*) calloc(capacity, sizeof(index_slot_t));
+    if(!index->slots) {
+        free(index);
+        return (MEMORY_ERROR);
+    }
+    index->capacity = capacity;
+    index->count = 0;
+
+    /* index every node which is already in the list. */
+    for(node_t *current = list->head.next; current != &list->head; current = current->next) {
+        if(index_covers(list, node_type(current)))
+            index_place(index, hash_data(list, node_data(current), node_type(current)), current);
+    }
+
+    list->index = index;
+    return (SUCCESS);
+}
+
+
+
+/*------------DROP THE HASH INDEX OF THE LIST------------*/
+status_t disable_index(list_t *list)
+{
+    if(!list)
+        return (INVALID_DATA);
+
+    if(list->index) {
+        free(list->index->slots);
+        free(list->index);
+        list->index = NULL;
+    }
+
+    return (SUCCESS);
+}
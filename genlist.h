@@ -12,6 +12,8 @@ enum Status {
     FALSE                   =   0,
     LIST_DATA_NOT_FOUND     =   2,
     LIST_EMPTY              =   3,
+    LIST_UNSUPPORTED        =   4,
+    LIST_IN_PROGRESS        =   5,      // an operation run in steps has steps left.
     INVALID_TYPE            =   0,
     INVALID_DATA            =   0,
     MEMORY_ERROR            =   -1
@@ -29,20 +31,349 @@ enum Data_Type {
 };
 
 
+/*------------ENUMERATION DESCRIBING WHERE THE NODE DATA LIVES------------*/
+enum Storage_Mode {
+    STORE_REFERENCE         =   0,      // 'data' points to client memory.
+    STORE_INLINE            =   1,      // the value is held in the node itself.
+    STORE_OWNED             =   2       // 'data' points to a copy right after the node, in the same allocation.
+};
+
+
+/*------------ENUMERATION DESCRIBING HOW THE LIST STORES ITS ELEMENTS------------*/
+enum List_Backend {
+    LINKED_LIST             =   0,      // one node per element.
+    UNROLLED_LIST           =   1,      // blocks of UNROLLED_BLOCK_SIZE elements.
+    PACKED_LIST             =   2       // 16-byte nodes linked by 28-bit indices.
+};
+
+
+/*------------ENUMERATION DESCRIBING THE SEARCH KERNELS------------*/
+enum Search_Kernel {
+    KERNEL_AUTO             =   0,      // best kernel of this CPU.
+    KERNEL_SCALAR           =   1,
+    KERNEL_SSE2             =   2,
+    KERNEL_AVX2             =   3
+};
+
+
 /*------------LINKED LIST NODE------------*/
 struct List_Node {
-    void *data;
+    union {
+        void *data;
+        int int_value;
+        double double_value;
+        char char_value;
+    };
     enum Data_Type type;
+    unsigned char storage;
+    unsigned char hash_tag;                     // STRING: one byte of the string hash, set on insertion.
+    unsigned short type_id;                     // registered STRUCTURE type, 0: the list default.
     struct List_Node *next;
     struct List_Node *prev;
+#ifdef GENLIST_JUMP
+    struct List_Node *jump;                     // hint only: a node GENLIST_PREFETCH_DISTANCE steps after, set by list_set_jumps().
+#endif
+};
+
+
+/*------------READ-ONLY VIEW OF ONE ELEMENT------------*/
+struct Node_View {
+    const void *data;                           // valid until the element is removed.
+    enum Data_Type type;
+};
+
+
+/*------------CURSOR ON ONE NODE OF A LIST------------*/
+struct List_Cursor {
+    struct List *list;
+    struct List_Node *node;                     // the head node: end of the list.
+};
+
+
+/*------------NODE POOL (slab pages of nodes with an intrusive free list, for the nodes linked in a list only)------------*/
+struct Node_Slab {
+    struct Node_Slab *next;
+    long unsigned int count;
+    struct List_Node nodes[];
+};
+
+struct Payload_Block {
+    struct Payload_Block *next;
+    char bytes[];
+};
+
+struct Node_Pool {
+    struct List_Node *free_nodes;
+    struct Node_Slab *slabs;
+    struct Payload_Block *payloads;             // data owned by the nodes (loaded lists), freed with the slabs.
+    long unsigned int capacity;
+    long unsigned int available;
+    long unsigned int references;               // lists (and merged pools) using this pool.
+    struct Node_Pool *forward;                  // merged into this pool, NULL: owns its slabs.
+};
+
+
+/*------------UNROLLED LIST BLOCK------------*/
+#define UNROLLED_BLOCK_SIZE     32
+#define UNROLLED_INLINE         0x80        // tag bit: value held inline.
+
+union Element_Value {
+    void *data;
+    int int_value;
+    double double_value;
+    char char_value;
+};
+
+struct Unrolled_Block {
+    union Element_Value values[UNROLLED_BLOCK_SIZE];
+    unsigned char tags[UNROLLED_BLOCK_SIZE];    // data type | UNROLLED_INLINE
+    unsigned int count;
+    struct Unrolled_Block *next;
+    struct Unrolled_Block *prev;
+};
+
+
+/*------------PACKED LIST NODE (links are indices into the packed pool, 0: the head)------------*/
+#define PACKED_INDEX_BITS       28
+#define PACKED_INDEX_MASK       ((1U << PACKED_INDEX_BITS) - 1)
+#define PACKED_MAX_NODES        PACKED_INDEX_MASK   // node 0 is the head.
+#define PACKED_CHUNK_BITS       16                  // nodes are allocated 65536 at a time (the first chunk grows up to it).
+#define PACKED_CHUNK_SIZE       (1U << PACKED_CHUNK_BITS)
+
+struct Packed_Node {
+    union Element_Value value;
+    unsigned int next;                          // top 4 bits: the data type.
+    unsigned int prev;                          // top bit: value held inline.
+};
+
+struct Packed_Pool {
+    struct Packed_Node **chunks;                // node i: chunks[i >> PACKED_CHUNK_BITS][i & (PACKED_CHUNK_SIZE - 1)].
+    unsigned int chunk_count;
+    unsigned int capacity;                      // nodes in the chunks.
+    unsigned int used;                          // nodes handed out at least once, the head included.
+    unsigned int free_nodes;                    // free list through 'next', 0: empty.
+};
+
+
+/*------------HASH INDEX (open addressing, value -> node)------------*/
+struct Index_Slot {
+    unsigned long long hash;
+    struct List_Node *node;                     // NULL: empty slot.
+};
+
+struct List_Index {
+    struct Index_Slot *slots;
+    long unsigned int capacity;                 // power of 2.
+    long unsigned int count;
+};
+
+
+/*------------SKIP LIST OVER AN ORDERED LIST (level 0 is the node ring itself)------------*/
+#define ORDER_MAX_LEVEL         16          // tower levels, a tower reaches level l with probability 4^-l.
+
+struct Order_Tower {
+    struct List_Node *node;                     // NULL: the head tower.
+    struct Order_Tower *next[];                 // next tower on each level of its height, NULL: none.
+};
+
+struct List_Order {
+    struct Order_Tower *head;                   // ORDER_MAX_LEVEL levels, before every node.
+    unsigned int levels;                        // levels in use.
+    unsigned long long seed;                    // random tower heights.
+};
+
+
+/*------------INCREMENTAL COMPACTION OF A LIST (in progress between two steps)------------*/
+struct List_Compaction {
+    struct Node_Slab *slab;                     // nodes are moved here, in list order.
+    long unsigned int used;                     // nodes of the slab taken so far.
+    struct List_Node *next;                     // next node to move, the head: done.
+};
+
+
+/*------------LIST OPERATION COUNTERS (per list, and summed over all lists)------------*/
+struct List_Stats {
+    long unsigned int inserts;
+    long unsigned int removals;
+    long unsigned int peak_length;              // per list only.
+    /* the counters below are kept only when built with GENLIST_STATS. */
+    long unsigned int allocations;              // nodes taken from the pool.
+    long unsigned int frees;                    // nodes given back by generic_delete().
+    long unsigned int heap_allocations;         // xmalloc() calls: summed only.
+    long unsigned int allocation_failures;      // xmalloc() calls which returned NULL: summed only.
+    long unsigned int searches;                 // search_node() calls.
+    long unsigned int visited;                  // nodes and index slots looked at by searches.
+    long unsigned int comparisons;              // data comparisons made by searches.
+};
+
+
+/*------------LATENCY HISTOGRAM OF ONE FUNCTION (built with GENLIST_LATENCY)------------*/
+#define LATENCY_BUCKETS         32          // bucket b: calls of [2^b, 2^(b+1)) ns.
+
+enum Stats_Function {
+    STAT_PUT_FRONT,
+    STAT_PUT_BACK,
+    STAT_PUT_AFTER,
+    STAT_PUT_BEFORE,
+    STAT_PUT_VALUE,                             // put_front_int ... put_back_char.
+    STAT_PUT_BULK,                              // put_front_bulk ... put_back_doubles.
+    STAT_POP_FRONT,
+    STAT_POP_BACK,
+    STAT_POP_AFTER,
+    STAT_POP_BEFORE,
+    STAT_REMOVE_DATA,
+    STAT_GET,                                   // get_front ... get_before.
+    STAT_PEEK,                                  // peek_front ... peek_before.
+    STAT_CONTAINS_DATA,
+    STAT_SORT_LIST,
+    STAT_CLEAR_LIST,
+    STAT_FUNCTIONS
+};
+
+struct Latency_Histogram {
+    long unsigned int calls;
+    long unsigned int total_ns;
+    long unsigned int buckets[LATENCY_BUCKETS];
+};
+
+struct Latency_Timer {
+    enum Stats_Function function;
+    long unsigned int start;                    // ns.
+};
+
+
+/*------------REGISTERED STRUCTURE TYPE (per list)------------*/
+#define TYPE_ID_SHIFT           8
+#define TYPE_BASE(type)         ((enum Data_Type)((type) & 0xff))
+#define TYPE_ID(type)           ((unsigned int)(type) >> TYPE_ID_SHIFT)
+#define MAX_STRUCTURE_TYPES     0xffff
+
+struct Structure_Type {
+    unsigned int size;
+    int (*compare)(const void*, const void*);   // 0: equal (also orders sort_list), NULL: byte-wise.
+    unsigned long long (*hash)(const void*);    // must agree with 'compare', NULL: hash of the bytes.
+    void (*display)(void*);                     // NULL: the show_list() callback.
+};
+
+
+/*------------LIST DESCRIPTOR------------*/
+struct List {
+    enum List_Backend backend;
+    struct List_Node head;                      // dummy node, holds the ring of data nodes.
+    struct Unrolled_Block *first_block;         // UNROLLED_LIST: blocks of elements.
+    struct Unrolled_Block *last_block;
+    struct Packed_Pool *packed;                 // PACKED_LIST: the nodes, NULL: none yet.
+    long unsigned int length;                   // number of data nodes.
+    struct Node_Pool *pool;                     // nodes of this list are taken from here.
+    unsigned int structure_size;                // STRUCTURE size for this list, 0: use STRUCTURE_SIZE.
+    int (*compare)(const void*, const void*);   // STRUCTURE comparator, NULL: byte-wise.
+    struct List_Index *index;                   // optional hash index, NULL: disabled.
+    struct List_Order *order;                   // skip list of an ordered list, NULL: unordered.
+    bool owns_data;                             // insertions copy the data into the nodes.
+    struct List_Compaction *compaction;         // compaction in progress, NULL: none.
+    struct List_Stats stats;
+    struct Structure_Type *types;               // registered types, id 1 is types[0].
+    unsigned int type_count;
+};
+
+
+/*------------CONCURRENT LIST DESCRIPTOR (two-lock queue)------------*/
+#define CACHE_LINE_SIZE         64
+
+struct Concurrent_List;                         // opaque: defined in genlist_concurrent.c.
+
+
+/*------------LOCK-FREE DEQUE (nodes addressed by index, 0: none)------------*/
+#define DEQUE_MAX_THREADS       32          // threads using one deque at the same time.
+#define DEQUE_HAZARDS           2           // hazard pointers per thread.
+#define DEQUE_RETIRE_LIMIT      (2 * DEQUE_MAX_THREADS * DEQUE_HAZARDS)
+
+struct Lockfree_Deque;                          // opaque: defined in genlist_lockfree.c.
+
+
+/*------------PERSISTENT LIST (one mapped file, links are offsets from its start, 0: none)------------*/
+#define PLIST_SIZE_CLASSES      32          // payload blocks of 16 << class bytes.
+
+struct Persistent_Node {
+    union {
+        unsigned long long data;                // offset of the STRING / STRUCTURE bytes.
+        int int_value;
+        double double_value;
+        char char_value;
+    };
+    unsigned long long next;
+    unsigned long long prev;
+    unsigned int type;                          // enum Data_Type.
+    unsigned int size;                          // payload bytes, 0: the value is inline.
+};
+
+struct Persistent_Header {
+    char magic[4];
+    unsigned short version;
+    unsigned short byte_order;
+    unsigned long long file_size;
+    unsigned long long used;                    // bytes handed out, the rest of the file is free.
+    unsigned long long length;                  // number of data nodes.
+    unsigned long long free_nodes;              // freed nodes, linked by 'next'.
+    unsigned long long free_payloads[PLIST_SIZE_CLASSES];  // freed payload blocks, by size class.
+    unsigned int structure_size;                // STRUCTURE size of this file.
+    unsigned int dirty;                         // 1: open, or not closed by close_plist() (links repaired on open).
+    struct Persistent_Node head;                // dummy node, holds the ring of data nodes.
+};
+
+struct Persistent_List {
+    char *base;                                 // start of the mapping, all offsets count from here.
+    unsigned long long mapped;                  // bytes mapped.
+    int fd;
+    bool opened;                                // the file passed the checks of open_plist().
+    int (*compare)(const void*, const void*);   // STRUCTURE comparator, NULL: byte-wise.
+};
+
+
+/*------------OUTPUT BUFFER (show_list, format_list)------------*/
+struct Out_Buffer {
+    char *data;
+    long unsigned int length;                   // bytes in use.
+    long unsigned int capacity;
+    int fd;                                     // >= 0: flushed to this file descriptor, < 0: growable memory.
+    bool owned;                                 // 'data' is freed by out_close().
+    enum Status status;                         // first error met, SUCCESS: none.
 };
 
 
 /*------------TYPEDEF------------*/
 typedef enum Status status_t;
 typedef enum Data_Type type_t;
+typedef enum Storage_Mode storage_t;
+typedef enum List_Backend backend_t;
+typedef enum Search_Kernel kernel_t;
+typedef union Element_Value value_t;
+typedef struct Unrolled_Block block_t;
+typedef struct Packed_Node packed_node_t;
+typedef struct Packed_Pool packed_pool_t;
 typedef struct List_Node node_t;
-typedef node_t list_t;
+typedef struct Node_View view_t;
+typedef struct List_Cursor list_cursor_t;
+typedef struct Node_Pool pool_t;
+typedef struct List list_t;
+typedef struct Concurrent_List clist_t;
+typedef struct Lockfree_Deque lfdeque_t;
+typedef struct Persistent_List plist_t;
+typedef struct List_Stats stats_t;
+typedef enum Stats_Function stats_function_t;
+typedef struct Latency_Histogram latency_t;
+typedef struct List_Index list_index_t;
+typedef struct Index_Slot index_slot_t;
+typedef struct List_Order list_order_t;
+typedef struct Order_Tower order_tower_t;
+typedef struct List_Compaction list_compaction_t;
+typedef unsigned long long hash_t;
+typedef int (*compare_t)(const void*, const void*);
+typedef unsigned long long (*hasher_t)(const void*);
+typedef void (*display_t)(void*);
+typedef struct Structure_Type structure_type_t;
+typedef struct Out_Buffer out_buffer_t;
+typedef void (*format_t)(out_buffer_t*, const void*);
 typedef long unsigned int len_t;
 typedef unsigned int size_t;
 typedef bool bool_t;
@@ -56,8 +387,13 @@ size_t STRUCTURE_SIZE;
 void export_structure(const size_t size);
 
 
-/*------------CREATE LIST HEAD NODE FUNCTION PROTOTYPE------------*/
+/*------------CREATE LIST FUNCTION PROTOTYPE------------*/
 list_t* create_list(void);
+list_t* create_list_as(const backend_t);
+status_t set_list_structure(list_t*, const size_t, compare_t);
+status_t set_list_owned(list_t*, const bool_t);
+type_t register_structure(list_t*, const size_t, compare_t, hasher_t, display_t);
+const structure_type_t* structure_type(const list_t*, const type_t);
 
 
 /*------------INSERT NODE FUNCTION PROTOTYPE------------*/
@@ -67,6 +403,24 @@ status_t put_after(list_t*, void*, const type_t, void*, const type_t);
 status_t put_before(list_t*, void*, const type_t, void*, const type_t);
 
 
+/*------------INSERT INLINE VALUE FUNCTION PROTOTYPE------------*/
+status_t put_front_int(list_t*, const int);
+status_t put_back_int(list_t*, const int);
+status_t put_front_double(list_t*, const double);
+status_t put_back_double(list_t*, const double);
+status_t put_front_char(list_t*, const char);
+status_t put_back_char(list_t*, const char);
+
+
+/*------------INSERT ARRAY FUNCTION PROTOTYPE (one allocation, one linking)------------*/
+status_t put_front_bulk(list_t*, void**, const type_t*, const len_t);
+status_t put_back_bulk(list_t*, void**, const type_t*, const len_t);
+status_t put_front_ints(list_t*, const int*, const len_t);
+status_t put_back_ints(list_t*, const int*, const len_t);
+status_t put_front_doubles(list_t*, const double*, const len_t);
+status_t put_back_doubles(list_t*, const double*, const len_t);
+
+
 /*------------DELETE NODE FUNCTION PROTOTYPE------------*/
 status_t pop_front(list_t*);
 status_t pop_back(list_t*);
@@ -75,21 +429,141 @@ status_t pop_before(list_t*, const void*, const type_t);
 status_t remove_data(list_t*, const void*, const type_t);
 
 
-/*------------GET NODE FUNCTION PROTOTYPE------------*/
+/*------------GET NODE FUNCTION PROTOTYPE (copies come from malloc(), not the pool: release_node() is free())------------*/
 status_t get_front(const list_t*, node_t**);
 status_t get_back(const list_t*, node_t**);
 status_t get_after(const list_t*, const void*, const type_t, node_t**);
 status_t get_before(const list_t*, const void*, const type_t, node_t**);
 
 
+/*------------VIEW NODE FUNCTION PROTOTYPE (no allocation)------------*/
+status_t peek_front(const list_t*, view_t*);
+status_t peek_back(const list_t*, view_t*);
+status_t peek_after(const list_t*, const void*, const type_t, view_t*);
+status_t peek_before(const list_t*, const void*, const type_t, view_t*);
+
+
+/*------------CURSOR FUNCTION PROTOTYPE (a cursor dangles once its node is deleted, or moved by list_compact*())------------*/
+status_t cursor_begin(list_t*, list_cursor_t*);
+status_t cursor_end(list_t*, list_cursor_t*);
+bool_t cursor_at_end(const list_cursor_t*);
+void cursor_next(list_cursor_t*);
+void cursor_prev(list_cursor_t*);
+status_t cursor_get(const list_cursor_t*, view_t*);
+status_t cursor_insert_before(list_cursor_t*, void*, const type_t);
+status_t cursor_insert_after(list_cursor_t*, void*, const type_t);
+status_t cursor_erase(list_cursor_t*);
+
+
+/*------------SPLICE FUNCTION PROTOTYPE (relinking, no copy)------------*/
+status_t list_splice(list_t*, node_t*, list_t*);
+status_t list_concat(list_t*, list_t*);
+list_t* list_split_at(list_t*, node_t*);
+
+
+/*------------SORT FUNCTION PROTOTYPE------------*/
+status_t sort_list(list_t*, compare_t);
+status_t list_set_jumps(list_t*);
+
+
+/*------------CONCURRENT LIST FUNCTION PROTOTYPE (thread-safe)------------*/
+clist_t* create_clist(compare_t);
+status_t clist_put_back(clist_t*, void*, const type_t);
+status_t clist_put_front(clist_t*, void*, const type_t);
+status_t clist_put_back_int(clist_t*, const int);
+status_t clist_pop_front(clist_t*, node_t*);
+status_t clist_contains(clist_t*, const void*, const type_t);
+len_t clist_length(const clist_t*);
+clist_t* destroy_clist(clist_t*);
+
+
+/*------------LOCK-FREE DEQUE FUNCTION PROTOTYPE (thread-safe)------------*/
+lfdeque_t* create_lfdeque(const len_t);
+status_t lfdeque_put_front(lfdeque_t*, void*, const type_t);
+status_t lfdeque_put_back(lfdeque_t*, void*, const type_t);
+status_t lfdeque_put_front_int(lfdeque_t*, const int);
+status_t lfdeque_put_back_int(lfdeque_t*, const int);
+status_t lfdeque_pop_front(lfdeque_t*, node_t*);
+status_t lfdeque_pop_back(lfdeque_t*, node_t*);
+status_t lfdeque_isEmpty(lfdeque_t*);
+lfdeque_t* destroy_lfdeque(lfdeque_t*);
+
+
+/*------------PERSISTENT LIST FUNCTION PROTOTYPE (memory-mapped file)------------*/
+plist_t* open_plist(const char*, const size_t, compare_t);
+status_t plist_put_front(plist_t*, const void*, const type_t);
+status_t plist_put_back(plist_t*, const void*, const type_t);
+status_t plist_put_back_int(plist_t*, const int);
+status_t plist_put_after(plist_t*, const void*, const type_t, const void*, const type_t);
+status_t plist_put_before(plist_t*, const void*, const type_t, const void*, const type_t);
+status_t plist_pop_front(plist_t*);
+status_t plist_pop_back(plist_t*);
+status_t plist_pop_after(plist_t*, const void*, const type_t);
+status_t plist_pop_before(plist_t*, const void*, const type_t);
+status_t plist_get_front(const plist_t*, node_t*);
+status_t plist_get_back(const plist_t*, node_t*);
+status_t plist_contains(const plist_t*, const void*, const type_t);
+status_t plist_remove_data(plist_t*, const void*, const type_t);
+len_t plist_length(const plist_t*);
+status_t show_plist(const plist_t*, display_t);
+status_t plist_sync(plist_t*);
+plist_t* close_plist(plist_t*);
+
+
+/*------------SERIALIZATION FUNCTION PROTOTYPE (binary, versioned)------------*/
+status_t list_save(const list_t*, const int);
+status_t list_load(list_t*, const int);
+
+
+/*------------MEMORY FUNCTION PROTOTYPE------------*/
+status_t reserve_list(list_t*, const len_t);
+void release_node(node_t*);
+/* compaction moves nodes: cursors, node_t* from search_node() and views of inline values become invalid. */
+status_t list_compact(list_t*);
+status_t list_compact_step(list_t*, const len_t);
+
+
+/*------------STATISTICS FUNCTION PROTOTYPE (NULL list: summed over all lists)------------*/
+status_t list_stats_get(const list_t*, stats_t*);
+status_t list_stats_reset(list_t*);
+status_t list_latency_get(const stats_function_t, latency_t*);
+const char* stats_function_name(const stats_function_t);
+
+
 /*------------MISCELLANEOUS FUNCTIONS------------*/
 status_t show_list(const list_t*, void (*struct_display)(void*));
 status_t show_data(const node_t*, void (*struct_display)(void*));
+
+
+/*------------OUTPUT FUNCTION PROTOTYPE (buffered)------------*/
+status_t out_open(out_buffer_t*, const int);
+status_t out_flush(out_buffer_t*);
+status_t out_close(out_buffer_t*);
+void out_bytes(out_buffer_t*, const char*, const len_t);
+void out_char(out_buffer_t*, const char);
+void out_string(out_buffer_t*, const char*);
+void out_int(out_buffer_t*, const int);
+void out_double(out_buffer_t*, const double);
+status_t format_list(const list_t*, out_buffer_t*, format_t);
+status_t format_data(const node_t*, out_buffer_t*, format_t);
 status_t contains_data(const list_t*, const void*, const type_t);
 len_t get_list_length(const list_t*);   
 bool_t isEmpty(const list_t*);
 
 
+/*------------HASH INDEX FUNCTION PROTOTYPE------------*/
+status_t enable_index(list_t*);
+status_t disable_index(list_t*);
+
+
+/*------------ORDERED LIST FUNCTION PROTOTYPE (skip list, O(log n) search and insert)------------*/
+status_t enable_order(list_t*);
+status_t disable_order(list_t*);
+status_t list_lower_bound(list_t*, const void*, const type_t, list_cursor_t*);
+status_t list_upper_bound(list_t*, const void*, const type_t, list_cursor_t*);
+status_t list_range(list_t*, const void*, const void*, const type_t, list_cursor_t*, list_cursor_t*);
+
+
 /*------------DESTROY LIST FUNCTION PROTOTYPE------------*/
 list_t* clear_list(list_t*);
 list_t* destroy_list(list_t*);
@@ -98,9 +572,156 @@ list_t* destroy_list(list_t*);
 /*------------HELPER FUNCTION PROTOTYPE------------*/
 void* xmalloc(const size_t);
 node_t* create_node(void *, const type_t);
-void generic_insert(node_t*, node_t*, node_t*);
-void generic_delete(node_t*);
+node_t* create_list_node(list_t*, void *, const type_t);
+node_t* copy_node(const node_t*);
+const void* node_data(const node_t*);
+type_t node_type(const node_t*);
+unsigned char string_tag(const char*);
+void tag_node(node_t*);
+status_t render_data(out_buffer_t*, const node_t*, display_t, format_t);
+status_t render_list(const list_t*, out_buffer_t*, display_t, format_t);
+void generic_insert(list_t*, node_t*, node_t*, node_t*);
+void generic_insert_chain(list_t*, node_t*, node_t*, node_t*, node_t*, const len_t);
+void generic_delete(list_t*, node_t*);
+node_t* pool_alloc(pool_t*);
+void pool_free(pool_t*, node_t*);
+status_t pool_reserve(pool_t*, const len_t);
+void pool_release(pool_t*);
+void pool_release_payloads(pool_t*);
+pool_t* create_pool(void);
+void pool_unref(pool_t*);
+void pool_merge(pool_t*, pool_t*);
+pool_t* list_pool(list_t*);
+void* pool_payload(pool_t*, const len_t);
+struct Node_Slab* pool_slab(pool_t*, const len_t);
+len_t pool_trim(pool_t*);
+void compact_stop(list_t*);
 node_t* search_node(const list_t*, const void*, const type_t type);
+bool_t match_data(const list_t*, const node_t*, const void*, const type_t);
+int compare_nodes(const list_t*, const node_t*, const node_t*, compare_t);
+bool_t index_covers(const list_t*, const type_t);
+hash_t hash_data(const list_t*, const void*, const type_t);
+void index_insert(list_t*, node_t*);
+void index_remove(list_t*, node_t*);
+void index_move(list_t*, node_t*, node_t*);
+node_t* index_find(const list_t*, const void*, const type_t);
+node_t* order_position(list_t*, const node_t*, order_tower_t**);
+void order_link(list_t*, node_t*, order_tower_t**);
+void order_remove(list_t*, node_t*);
+void order_move(list_t*, node_t*, node_t*);
+node_t* order_find(const list_t*, const void*, const type_t);
+void order_clear(list_t*);
+
+
+/*------------UNROLLED BACKEND FUNCTION PROTOTYPE (genlist_unrolled.c)------------*/
+status_t unrolled_put_front(list_t*, const value_t, const unsigned char);
+status_t unrolled_put_back(list_t*, const value_t, const unsigned char);
+status_t unrolled_put_after(list_t*, const void*, const type_t, const value_t, const unsigned char);
+status_t unrolled_put_before(list_t*, const void*, const type_t, const value_t, const unsigned char);
+status_t unrolled_pop_front(list_t*);
+status_t unrolled_pop_back(list_t*);
+status_t unrolled_pop_after(list_t*, const void*, const type_t);
+status_t unrolled_pop_before(list_t*, const void*, const type_t);
+status_t unrolled_remove_data(list_t*, const void*, const type_t);
+status_t unrolled_get_front(const list_t*, node_t**);
+status_t unrolled_get_back(const list_t*, node_t**);
+status_t unrolled_get_after(const list_t*, const void*, const type_t, node_t**);
+status_t unrolled_get_before(const list_t*, const void*, const type_t, node_t**);
+status_t unrolled_render_list(const list_t*, out_buffer_t*, display_t, format_t);
+bool_t unrolled_contains(const list_t*, const void*, const type_t);
+status_t unrolled_peek_front(const list_t*, view_t*);
+status_t unrolled_peek_back(const list_t*, view_t*);
+status_t unrolled_peek_after(const list_t*, const void*, const type_t, view_t*);
+status_t unrolled_peek_before(const list_t*, const void*, const type_t, view_t*);
+void unrolled_concat(list_t*, list_t*);
+void unrolled_clear(list_t*);
+
+
+/*------------PACKED BACKEND FUNCTION PROTOTYPE (genlist_packed.c)------------*/
+status_t packed_put_front(list_t*, const value_t, const unsigned char);
+status_t packed_put_back(list_t*, const value_t, const unsigned char);
+status_t packed_put_after(list_t*, const void*, const type_t, const value_t, const unsigned char);
+status_t packed_put_before(list_t*, const void*, const type_t, const value_t, const unsigned char);
+status_t packed_pop_front(list_t*);
+status_t packed_pop_back(list_t*);
+status_t packed_pop_after(list_t*, const void*, const type_t);
+status_t packed_pop_before(list_t*, const void*, const type_t);
+status_t packed_remove_data(list_t*, const void*, const type_t);
+status_t packed_get_front(const list_t*, node_t**);
+status_t packed_get_back(const list_t*, node_t**);
+status_t packed_get_after(const list_t*, const void*, const type_t, node_t**);
+status_t packed_get_before(const list_t*, const void*, const type_t, node_t**);
+status_t packed_render_list(const list_t*, out_buffer_t*, display_t, format_t);
+bool_t packed_contains(const list_t*, const void*, const type_t);
+status_t packed_peek_front(const list_t*, view_t*);
+status_t packed_peek_back(const list_t*, view_t*);
+status_t packed_peek_after(const list_t*, const void*, const type_t, view_t*);
+status_t packed_peek_before(const list_t*, const void*, const type_t, view_t*);
+status_t packed_reserve(list_t*, const len_t);
+status_t packed_concat(list_t*, list_t*);
+void packed_clear(list_t*);
+
+
+/*------------INSTRUMENTATION (compiled out unless built with -DGENLIST_STATS / -DGENLIST_LATENCY)------------*/
+extern __thread stats_t *genlist_thread_stats;
+extern latency_t genlist_latency[STAT_FUNCTIONS];
+void stats_register(void);
+long unsigned int stats_clock(void);
+void latency_end(struct Latency_Timer*);
+
+#ifdef GENLIST_STATS
+/* sums over all lists are kept per thread: only the owner thread writes them, no atomic add needed. */
+#define STATS_GLOBAL(counter, n) \
+    ((genlist_thread_stats ? (void)0 : stats_register()), \
+    __atomic_store_n(&genlist_thread_stats->counter, genlist_thread_stats->counter + (n), __ATOMIC_RELAXED))
+#define STATS_COUNT(list, counter, n) \
+    (((list_t*)(list))->stats.counter += (n), STATS_GLOBAL(counter, n))
+#else
+#define STATS_COUNT(list, counter, n)   ((void)sizeof(n))
+#define STATS_GLOBAL(counter, n)        ((void)sizeof(n))
+#endif
+
+#ifdef GENLIST_LATENCY
+/* times the rest of the enclosing function, whatever return it leaves by. */
+#define STATS_LATENCY(function) \
+    struct Latency_Timer latency_timer __attribute__((cleanup(latency_end))) = { (function), stats_clock() }
+#else
+#define STATS_LATENCY(function)         ((void)0)
+#endif
+
+
+/*------------SOFTWARE PREFETCH IN NODE WALKS (-DGENLIST_PREFETCH_DISTANCE=n, 0: off / -DGENLIST_JUMP)------------*/
+#ifndef GENLIST_PREFETCH_DISTANCE
+#define GENLIST_PREFETCH_DISTANCE       8
+#endif
+
+#if GENLIST_PREFETCH_DISTANCE > 0
+#define PREFETCH(address)               __builtin_prefetch((address), 0, 3)
+#else
+#define PREFETCH(address)               ((void)0)
+#endif
+
+/* the data of a node, when it lives outside the node's own cache line. */
+#define PREFETCH_DATA(node) \
+    ((node)->storage == STORE_REFERENCE ? PREFETCH((node)->data) : (void)0)
+
+#if defined(GENLIST_JUMP) && GENLIST_PREFETCH_DISTANCE > 0
+/* the jumps are set by list_set_jumps() (sort_list() and list_compact() call it): the walks only read them,
+so a read-only walk writes nothing. A prefetch never faults: a stale jump is only a wasted fetch. */
+#define PREFETCH_AHEAD(node)            PREFETCH((node)->jump)
+#define PREFETCH_JUMP_CLEAR(node)       ((node)->jump = NULL)
+#else
+/* without jump pointers the node after next is the farthest one reachable: its address is in the next node. */
+#define PREFETCH_AHEAD(node)            PREFETCH((node)->next->next)
+#define PREFETCH_JUMP_CLEAR(node)       ((void)0)
+#endif
+
+
+/*------------SEARCH KERNEL FUNCTION PROTOTYPE (genlist_simd.c)------------*/
+status_t select_search_kernel(const kernel_t);
+kernel_t search_kernel(void);
+unsigned int match_tags(const block_t*, const unsigned char);
+unsigned int match_values(const block_t*, const value_t);
 
 
 #endif
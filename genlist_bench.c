@@ -0,0 +1,830 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/resource.h>
+#include "genlist.h"
+
+
+/*------------BENCHMARK SIZES------------*/
+#define LIST_SIZE       1000000
+#define SEARCH_COUNT    200
+#define SORTED_SIZE     20000           // random values kept sorted by insertion.
+#define MAX_PAIRS       8               // up to this many producer / consumer threads of each kind.
+#define THREAD_ITEMS    250000          // values put by each producer.
+#define SUITE_SIZE      100000          // default list size of the suite workloads.
+#define SUITE_ROUNDS    5               // default runs of each workload.
+#define SUITE_BATCH     256             // fast operations are timed this many at a time.
+
+
+/*------------MONOTONIC CLOCK IN NANOSECONDS------------*/
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+
+/*------------FILL A LIST WITH 0 .. LIST_SIZE-1 (held inline)------------*/
+static list_t* build_list(const backend_t backend)
+{
+    list_t *list = create_list_as(backend);
+
+    for(int i = 0; i < LIST_SIZE; i++) {
+        status_t status = put_back_int(list, i);
+        if(status != SUCCESS) {
+            fprintf(stderr, "put_back_int failed\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return list;
+}
+
+
+/*------------TIME contains_data() ON KEYS SPREAD OVER THE LIST (avg ns per search)------------*/
+static double bench_search(const list_t *list)
+{
+    int found = 0;
+    double start = now_ns();
+
+    for(int i = 0; i < SEARCH_COUNT; i++) {
+        /* keys in the second half of the list, the last one missing: long scans. */
+        int key = LIST_SIZE / 2 + (int)((long)i * (LIST_SIZE / 2) / SEARCH_COUNT);
+        if(i == SEARCH_COUNT - 1)
+            key = -1;
+        found += contains_data(list, &key, INTEGER) == TRUE;
+    }
+
+    double elapsed = now_ns() - start;
+
+    if(found != SEARCH_COUNT - 1) {
+        fprintf(stderr, "search returned wrong results\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return elapsed / SEARCH_COUNT;
+}
+
+
+/*------------INSERT SORTED_SIZE RANDOM VALUES IN ORDER: WALK + put_before BY HAND vs AN ORDERED LIST (ns per insert)------------*/
+static double bench_sorted_insert(const bool_t ordered)
+{
+    list_t *list = create_list();
+    if(ordered)
+        enable_order(list);
+
+    srand(7);
+    double start = now_ns();
+
+    for(int i = 0; i < SORTED_SIZE; i++) {
+        int value = rand();
+        if(ordered) {
+            put_back_int(list, value);
+            continue;
+        }
+
+        /* what callers did so far: find the first greater node, insert before it. */
+        list_cursor_t cursor;
+        cursor_begin(list, &cursor);
+        while(!cursor_at_end(&cursor) && cursor.node->int_value <= value)
+            cursor_next(&cursor);
+
+        node_t *newNode = create_list_node(list, NULL, INTEGER);
+        newNode->int_value = value;
+        newNode->storage = STORE_INLINE;
+        generic_insert(list, cursor.node->prev, newNode, cursor.node);
+    }
+
+    double elapsed = now_ns() - start;
+
+    for(const node_t *current = list->head.next; current->next != &list->head; current = current->next) {
+        if(current->int_value > current->next->int_value) {
+            fprintf(stderr, "sorted insertion out of order\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    list = destroy_list(list);
+    return elapsed / SORTED_SIZE;
+}
+
+
+/*------------DUMP THE LIST TO /dev/null: ONE fprintf() PER ITEM vs format_list() (ns per node)------------*/
+static double bench_dump(const list_t *list, const bool_t buffered)
+{
+    double start = now_ns();
+
+    if(buffered) {
+        out_buffer_t out;
+        int fd = open("/dev/null", O_WRONLY);
+        out_open(&out, fd);
+        format_list(list, &out, NULL);
+        out_close(&out);
+        close(fd);
+    } else {
+        /* what show_list() used to do, node by node. */
+        FILE *sink = fopen("/dev/null", "w");
+        fprintf(sink, "[START] <-> ");
+        for(const node_t *current = list->head.next; current != &list->head; current = current->next) {
+            if(current->type == INTEGER)
+                fprintf(sink, "[%d]", current->int_value);
+            else
+                fprintf(sink, "[%lf]", current->double_value);
+            fprintf(sink, " <-> ");
+        }
+        fprintf(sink, "[END]\n");
+        fclose(sink);
+    }
+
+    return (now_ns() - start) / list->length;
+}
+
+
+/*------------SAVE AND LOAD THE LIST THROUGH A FILE: fprintf / fscanf TEXT vs list_save / list_load (ns per node)------------*/
+static void bench_serial(const list_t *list, double *save_ns, double *load_ns, const bool_t binary)
+{
+    char path[] = "/tmp/genlist_bench_XXXXXX";
+    int fd = mkstemp(path);
+    list_t *loaded = create_list();
+    status_t status = SUCCESS;
+
+    double start = now_ns();
+    if(binary) {
+        status = list_save(list, fd);
+    } else {
+        FILE *file = fdopen(dup(fd), "w");
+        for(const node_t *current = list->head.next; current != &list->head; current = current->next)
+            fprintf(file, "%d\n", current->int_value);
+        fclose(file);
+    }
+    double middle = now_ns();
+
+    lseek(fd, 0, SEEK_SET);
+    if(binary) {
+        status |= list_load(loaded, fd);
+    } else {
+        FILE *file = fdopen(dup(fd), "r");
+        int value;
+        while(fscanf(file, "%d", &value) == 1)
+            status |= put_back_int(loaded, value);
+        fclose(file);
+    }
+    double end = now_ns();
+
+    if(status != SUCCESS || loaded->length != list->length || loaded->head.prev->int_value != list->head.prev->int_value) {
+        fprintf(stderr, "save / load lost data\n");
+        exit(EXIT_FAILURE);
+    }
+
+    *save_ns = (middle - start) / list->length;
+    *load_ns = (end - middle) / list->length;
+
+    loaded = destroy_list(loaded);
+    close(fd);
+    unlink(path);
+}
+
+
+#ifdef GENLIST_PERSIST
+/*------------COLD START: REBUILD WITH list_load() vs MAP THE PERSISTENT LIST AGAIN (us until the last value is read)------------*/
+static void bench_startup(const list_t *list, double *load_us, double *map_us)
+{
+    char path[] = "/tmp/genlist_bench_XXXXXX";
+    int fd = mkstemp(path);
+    list_save(list, fd);
+
+    lseek(fd, 0, SEEK_SET);
+    double start = now_ns();
+    list_t *loaded = create_list();
+    status_t status = list_load(loaded, fd);
+    int last = loaded->head.prev->int_value;
+    *load_us = (now_ns() - start) / 1000;
+    loaded = destroy_list(loaded);
+    close(fd);
+    unlink(path);
+
+    /* the persistent file is written once, then opened as a restarted process would. */
+    plist_t *persistent = open_plist(path, 0, NULL);
+    for(const node_t *current = list->head.next; current != &list->head; current = current->next)
+        status |= plist_put_back_int(persistent, current->int_value);
+    persistent = close_plist(persistent);
+
+    node_t back;
+    start = now_ns();
+    persistent = open_plist(path, 0, NULL);
+    status |= plist_get_back(persistent, &back);
+    *map_us = (now_ns() - start) / 1000;
+
+    if(status != SUCCESS || back.int_value != last || plist_length(persistent) != list->length) {
+        fprintf(stderr, "persistent list lost data\n");
+        exit(EXIT_FAILURE);
+    }
+
+    persistent = close_plist(persistent);
+    unlink(path);
+}
+#endif
+
+
+/*------------PRODUCER / CONSUMER RUN ON ONE QUEUE------------*/
+enum Queue_Kind {
+    QUEUE_MUTEX,                        // plain list behind one global mutex.
+    QUEUE_CLIST,                        // concurrent list (head + tail locks).
+    QUEUE_LFDEQUE                       // lock-free deque.
+};
+
+struct Queue_Run {
+    enum Queue_Kind kind;
+    int pairs;                          // producer / consumer threads of each kind.
+    list_t *list;
+    clist_t *clist;
+    lfdeque_t *deque;
+    pthread_mutex_t lock;
+    long unsigned int consumed;         // values taken so far, by all consumers.
+    long long checksum;                 // sum of the values taken.
+};
+
+
+static void* producer(void *arg)
+{
+    struct Queue_Run *run = arg;
+
+    for(int i = 1; i <= THREAD_ITEMS; i++) {
+        switch(run->kind) {
+            case QUEUE_MUTEX:
+                pthread_mutex_lock(&run->lock);
+                put_back_int(run->list, i);
+                pthread_mutex_unlock(&run->lock);
+                break;
+            case QUEUE_CLIST:
+                clist_put_back_int(run->clist, i);
+                break;
+            case QUEUE_LFDEQUE:
+                lfdeque_put_back_int(run->deque, i);
+                break;
+        }
+    }
+
+    return NULL;
+}
+
+
+static void* consumer(void *arg)
+{
+    struct Queue_Run *run = arg;
+    const long unsigned int total = (long unsigned int)run->pairs * THREAD_ITEMS;
+    long long checksum = 0;
+    node_t value;
+
+    while(__atomic_load_n(&run->consumed, __ATOMIC_RELAXED) < total) {
+        status_t status = FAILED;
+        switch(run->kind) {
+            case QUEUE_MUTEX:
+                pthread_mutex_lock(&run->lock);
+                value.int_value = isEmpty(run->list) ? 0 : run->list->head.next->int_value;
+                status = pop_front(run->list);
+                pthread_mutex_unlock(&run->lock);
+                break;
+            case QUEUE_CLIST:
+                status = clist_pop_front(run->clist, &value);
+                break;
+            case QUEUE_LFDEQUE:
+                status = lfdeque_pop_front(run->deque, &value);
+                break;
+        }
+
+        if(status == SUCCESS) {
+            checksum += value.int_value;
+            __atomic_fetch_add(&run->consumed, 1, __ATOMIC_RELAXED);
+        } else {
+            sched_yield();
+        }
+    }
+
+    __atomic_fetch_add(&run->checksum, checksum, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+
+/*------------TIME 'pairs' PRODUCERS AND CONSUMERS, CHECK NOTHING IS LOST (million values per second)------------*/
+static double bench_queue(const enum Queue_Kind kind, const int pairs)
+{
+    struct Queue_Run run = { kind, pairs, NULL, NULL, NULL, PTHREAD_MUTEX_INITIALIZER, 0, 0 };
+    pthread_t threads[2 * MAX_PAIRS];
+
+    run.list = create_list();
+    run.clist = create_clist(NULL);
+    run.deque = create_lfdeque((len_t)pairs * THREAD_ITEMS);
+
+    double start = now_ns();
+
+    for(int i = 0; i < pairs; i++) {
+        pthread_create(&threads[2 * i], NULL, producer, &run);
+        pthread_create(&threads[2 * i + 1], NULL, consumer, &run);
+    }
+    for(int i = 0; i < 2 * pairs; i++)
+        pthread_join(threads[i], NULL);
+
+    double elapsed = now_ns() - start;
+
+    long long expected = (long long)pairs * THREAD_ITEMS * (THREAD_ITEMS + 1) / 2;
+    bool_t empty = isEmpty(run.list) == TRUE && clist_length(run.clist) == 0 && lfdeque_isEmpty(run.deque) == TRUE;
+    if(run.checksum != expected || !empty) {
+        fprintf(stderr, "queue lost or duplicated values\n");
+        exit(EXIT_FAILURE);
+    }
+
+    run.list = destroy_list(run.list);
+    run.clist = destroy_clist(run.clist);
+    run.deque = destroy_lfdeque(run.deque);
+
+    return (double)pairs * THREAD_ITEMS * 1e3 / elapsed;
+}
+
+
+/*------------SUITE: TIMING SAMPLES (ns per operation, one per timed batch)------------*/
+struct Samples {
+    double *values;
+    len_t count;
+    len_t capacity;
+    double total_ns;
+    len_t ops;
+};
+
+static void record(struct Samples *samples, const double ns, const len_t ops)
+{
+    if(samples->count == samples->capacity) {
+        samples->capacity = samples->capacity ? samples->capacity * 2 : 1024;
+        samples->values = (double*) realloc(samples->values, samples->capacity * sizeof(double));
+        if(!samples->values) {
+            fprintf(stderr, "out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    samples->values[samples->count++] = ns / ops;
+    samples->total_ns += ns;
+    samples->ops += ops;
+}
+
+static int compare_samples(const void *a, const void *b)
+{
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const struct Samples *samples, const double rank)
+{
+    len_t i = (len_t)(rank * (double)(samples->count - 1) + 0.5);
+    return samples->values[i];
+}
+
+
+
+/*------------SUITE: ONE JSON LINE PER WORKLOAD------------*/
+static void report(const char *workload, const len_t size, struct Samples *samples)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    qsort(samples->values, samples->count, sizeof(double), compare_samples);
+    double ns = samples->total_ns / samples->ops;
+
+    fprintf(stdout, "{\"workload\":\"%s\",\"size\":%lu,\"ops\":%lu,\"samples\":%lu,"
+        "\"ns_per_op\":%.2f,\"ops_per_sec\":%.0f,\"p50_ns\":%.2f,\"p90_ns\":%.2f,\"p99_ns\":%.2f,"
+        "\"max_ns\":%.2f,\"peak_rss_kb\":%ld}\n",
+        workload, size, samples->ops, samples->count, ns, 1e9 / ns,
+        percentile(samples, 0.50), percentile(samples, 0.90), percentile(samples, 0.99),
+        samples->values[samples->count - 1], (long)usage.ru_maxrss);
+    fflush(stdout);
+
+    free(samples->values);
+    memset(samples, 0, sizeof(*samples));
+}
+
+static void must(const status_t status, const char *what)
+{
+    if(status != SUCCESS) {
+        fprintf(stderr, "%s failed\n", what);
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+
+/*------------SUITE WORKLOADS (each run is one round, timed into 'samples')------------*/
+struct Bench_Record {
+    int id;
+    double score;
+    char name[16];
+};
+
+static int compare_records(const void *a, const void *b)
+{
+    int x = ((const struct Bench_Record*)a)->id, y = ((const struct Bench_Record*)b)->id;
+    return (x > y) - (x < y);
+}
+
+static len_t slow_ops(const len_t size)
+{
+    /* O(n) operations: enough of them for percentiles, few enough to finish. */
+    return (size / 100 < 100) ? 100 : size / 100;
+}
+
+/* put_back + pop_front on a list holding 'size' values. */
+static void workload_queue(const len_t size, struct Samples *samples)
+{
+    list_t *list = create_list();
+    for(len_t i = 0; i < size; i++)
+        must(put_back_int(list, (int)i), "put_back_int");
+
+    for(len_t done = 0; done < size; done += SUITE_BATCH) {
+        double start = now_ns();
+        for(int j = 0; j < SUITE_BATCH; j++) {
+            put_back_int(list, j);
+            pop_front(list);
+        }
+        record(samples, now_ns() - start, 2 * SUITE_BATCH);
+    }
+
+    list = destroy_list(list);
+}
+
+/* put_front + pop_front on a list holding 'size' values. */
+static void workload_stack(const len_t size, struct Samples *samples)
+{
+    list_t *list = create_list();
+    for(len_t i = 0; i < size; i++)
+        must(put_front_int(list, (int)i), "put_front_int");
+
+    for(len_t done = 0; done < size; done += SUITE_BATCH) {
+        double start = now_ns();
+        for(int j = 0; j < SUITE_BATCH; j++) {
+            put_front_int(list, j);
+            pop_front(list);
+        }
+        record(samples, now_ns() - start, 2 * SUITE_BATCH);
+    }
+
+    list = destroy_list(list);
+}
+
+/* put_after a random existing value: a search, then one link. */
+static void workload_middle_insert(const len_t size, struct Samples *samples)
+{
+    len_t count = slow_ops(size);
+    int *keys = (int*) malloc(size * sizeof(int));
+    int *values = (int*) malloc(count * sizeof(int));
+    for(len_t i = 0; i < size; i++)
+        keys[i] = (int)i;
+
+    list_t *list = create_list();
+    must(put_back_ints(list, keys, size), "put_back_ints");
+
+    for(len_t i = 0; i < count; i++) {
+        int *key = &keys[rand() % size];
+        values[i] = -(int)i - 1;
+
+        double start = now_ns();
+        must(put_after(list, key, INTEGER, &values[i], INTEGER), "put_after");
+        record(samples, now_ns() - start, 1);
+    }
+
+    list = destroy_list(list);
+    free(keys);
+    free(values);
+}
+
+/* contains_data on random keys, half of them missing. */
+static void workload_search(const len_t size, struct Samples *samples)
+{
+    list_t *list = create_list();
+    for(len_t i = 0; i < size; i++)
+        must(put_back_int(list, (int)i), "put_back_int");
+
+    for(len_t i = 0; i < slow_ops(size); i++) {
+        int key = rand() % (int)(2 * size);
+
+        double start = now_ns();
+        status_t found = contains_data(list, &key, INTEGER);
+        record(samples, now_ns() - start, 1);
+
+        if((found == TRUE) != (key < (int)size)) {
+            fprintf(stderr, "contains_data returned a wrong result\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    list = destroy_list(list);
+}
+
+/* get_list_length, over and over. */
+static void workload_length(const len_t size, struct Samples *samples)
+{
+    list_t *list = create_list();
+    for(len_t i = 0; i < size; i++)
+        must(put_back_int(list, (int)i), "put_back_int");
+
+    volatile len_t sink = 0;
+    for(len_t done = 0; done < size; done += SUITE_BATCH) {
+        double start = now_ns();
+        for(int j = 0; j < SUITE_BATCH; j++)
+            sink += get_list_length(list);
+        record(samples, now_ns() - start, SUITE_BATCH);
+    }
+
+    list = destroy_list(list);
+}
+
+/* clear_list, then destroy_list, of 'size' nodes: ns per node. */
+static void workload_clear(const len_t size, struct Samples *samples)
+{
+    list_t *list = create_list();
+    for(len_t i = 0; i < size; i++)
+        must(put_back_int(list, (int)i), "put_back_int");
+
+    double start = now_ns();
+    clear_list(list);
+    record(samples, now_ns() - start, size);
+
+    list = destroy_list(list);
+}
+
+static void workload_destroy(const len_t size, struct Samples *samples)
+{
+    list_t *list = create_list();
+    for(len_t i = 0; i < size; i++)
+        must(put_back_int(list, (int)i), "put_back_int");
+
+    double start = now_ns();
+    list = destroy_list(list);
+    record(samples, now_ns() - start, size);
+}
+
+/* put_back of the five data types in turn, then pop_front of all of them. */
+static void workload_mixed(const len_t size, struct Samples *samples)
+{
+    static const char *words[] = { "alpha", "beta", "gamma", "delta" };
+    static struct Bench_Record record_data = { 1, 2.5, "record" };
+
+    list_t *list = create_list();
+    set_list_structure(list, sizeof(struct Bench_Record), compare_records);
+
+    for(len_t done = 0; done < size; done += SUITE_BATCH) {
+        double start = now_ns();
+        for(int j = 0; j < SUITE_BATCH; j++) {
+            switch(j % 5) {
+                case 0: put_back_int(list, j); break;
+                case 1: put_back_double(list, j * 0.5); break;
+                case 2: put_back_char(list, (char)('a' + j % 26)); break;
+                case 3: put_back(list, (void*)words[j % 4], STRING); break;
+                default: put_back(list, &record_data, STRUCTURE); break;
+            }
+        }
+        record(samples, now_ns() - start, SUITE_BATCH);
+    }
+
+    while(!isEmpty(list)) {
+        double start = now_ns();
+        len_t popped = 0;
+        for(; popped < SUITE_BATCH && pop_front(list) == SUCCESS; popped++)
+            ;
+        record(samples, now_ns() - start, popped);
+    }
+
+    list = destroy_list(list);
+}
+
+/* STRUCTURE payloads of a registered type: put_back (timed when 'samples' is given). */
+static list_t* structure_list(const len_t size, struct Bench_Record *records, type_t *record_type, struct Samples *samples)
+{
+    list_t *list = create_list();
+    *record_type = register_structure(list, sizeof(struct Bench_Record), compare_records, NULL, NULL);
+
+    for(len_t i = 0; i < size; i++) {
+        records[i].id = (int)i;
+        records[i].score = (double)i / 3;
+        snprintf(records[i].name, sizeof(records[i].name), "r%d", (int)i);
+    }
+
+    for(len_t done = 0; done < size; done += SUITE_BATCH) {
+        double start = now_ns();
+        len_t end = (done + SUITE_BATCH < size) ? done + SUITE_BATCH : size;
+        for(len_t i = done; i < end; i++)
+            must(put_back(list, &records[i], *record_type), "put_back (STRUCTURE)");
+        if(samples)
+            record(samples, now_ns() - start, end - done);
+    }
+
+    return (list);
+}
+
+static void workload_structure_put(const len_t size, struct Samples *samples)
+{
+    struct Bench_Record *records = (struct Bench_Record*) calloc(size, sizeof(struct Bench_Record));
+    type_t record_type;
+
+    list_t *list = structure_list(size, records, &record_type, samples);
+
+    list = destroy_list(list);
+    free(records);
+}
+
+/* contains_data on STRUCTURE payloads, through the comparator of their type. */
+static void workload_structure_search(const len_t size, struct Samples *samples)
+{
+    struct Bench_Record *records = (struct Bench_Record*) calloc(size, sizeof(struct Bench_Record));
+    type_t record_type;
+
+    list_t *list = structure_list(size, records, &record_type, NULL);
+
+    for(len_t i = 0; i < slow_ops(size); i++) {
+        struct Bench_Record key = records[rand() % size];
+
+        double start = now_ns();
+        status_t found = contains_data(list, &key, record_type);
+        record(samples, now_ns() - start, 1);
+        must(found, "contains_data (STRUCTURE)");
+    }
+
+    list = destroy_list(list);
+    free(records);
+}
+
+
+
+/*------------SUITE: RUN THE WORKLOADS, ONE JSON LINE EACH------------*/
+/* usage: runBenchmark suite [size] [rounds] [workload] */
+static int run_suite(const int argc, char **argv)
+{
+    static const struct {
+        const char *name;
+        void (*run)(const len_t, struct Samples*);
+    } workloads[] = {
+        { "queue", workload_queue },
+        { "stack", workload_stack },
+        { "middle_insert", workload_middle_insert },
+        { "search", workload_search },
+        { "length", workload_length },
+        { "clear_list", workload_clear },
+        { "destroy_list", workload_destroy },
+        { "mixed", workload_mixed },
+        { "structure_put", workload_structure_put },
+        { "structure_search", workload_structure_search }
+    };
+
+    len_t size = (argc > 0) ? strtoul(argv[0], NULL, 10) : SUITE_SIZE;
+    int rounds = (argc > 1) ? atoi(argv[1]) : SUITE_ROUNDS;
+    const char *only = (argc > 2) ? argv[2] : NULL;
+    if(size == 0 || rounds <= 0) {
+        fprintf(stderr, "usage: runBenchmark suite [size] [rounds] [workload]\n");
+        return (EXIT_FAILURE);
+    }
+
+    struct Samples samples;
+    memset(&samples, 0, sizeof(samples));
+    srand(1);
+
+    int ran = 0;
+    for(unsigned int i = 0; i < sizeof(workloads) / sizeof(workloads[0]); i++) {
+        if(only && strcmp(only, workloads[i].name) != 0)
+            continue;
+
+        for(int round = 0; round < rounds; round++)
+            workloads[i].run(size, &samples);
+        report(workloads[i].name, size, &samples);
+        ran++;
+    }
+
+    if(!ran) {
+        fprintf(stderr, "unknown workload: %s\n", only);
+        return (EXIT_FAILURE);
+    }
+
+    return (EXIT_SUCCESS);
+}
+
+
+/*------------MAIN FUNCTION------------*/
+int main(int argc, char **argv) {
+
+    /* machine-readable suite, to compare commits. */
+    if(argc > 1 && strcmp(argv[1], "suite") == 0)
+        return run_suite(argc - 2, argv + 2);
+
+    const char *kernel_names[] = { "auto", "scalar", "sse2", "avx2" };
+    const char line[] = "----------------------------------------------------------------";
+
+    list_t *linked = build_list(LINKED_LIST);
+    list_t *unrolled = build_list(UNROLLED_LIST);
+
+
+    /*----------------------------------------------------------------------------------*/
+    puts(line);
+    fprintf(stdout, "contains_data() on %d INTEGER elements, %d searches\n", LIST_SIZE, SEARCH_COUNT);
+    puts(line);
+
+    double baseline = bench_search(linked);
+    fprintf(stdout, "%-10s %-8s %12.0f ns/search %8.2fx\n", "linked", "-", baseline, 1.0);
+
+    for(kernel_t kernel = KERNEL_SCALAR; kernel <= KERNEL_AVX2; kernel++) {
+        if(select_search_kernel(kernel) != SUCCESS) {
+            fprintf(stdout, "%-10s %-8s %12s\n", "unrolled", kernel_names[kernel], "n/a");
+            continue;
+        }
+
+        double ns = bench_search(unrolled);
+        fprintf(stdout, "%-10s %-8s %12.0f ns/search %8.2fx\n", "unrolled", kernel_names[kernel], ns, baseline / ns);
+    }
+    select_search_kernel(KERNEL_AUTO);
+
+    list_t *ordered = build_list(LINKED_LIST);
+    enable_order(ordered);
+    double ns = bench_search(ordered);
+    fprintf(stdout, "%-10s %-8s %12.0f ns/search %8.2fx\n", "ordered", "-", ns, baseline / ns);
+    ordered = destroy_list(ordered);
+
+
+    /*----------------------------------------------------------------------------------*/
+    puts(line);
+    fprintf(stdout, "sorted insertion of %d random INTEGER values (ns/insert)\n", SORTED_SIZE);
+    puts(line);
+
+    double by_hand = bench_sorted_insert(false);
+    double skip_list = bench_sorted_insert(true);
+    fprintf(stdout, "%-16s %12.0f\n", "walk + insert", by_hand);
+    fprintf(stdout, "%-16s %12.0f %8.2fx\n", "ordered list", skip_list, by_hand / skip_list);
+
+
+    /*----------------------------------------------------------------------------------*/
+    list_t *doubles = create_list();
+    for(int i = 0; i < LIST_SIZE; i++)
+        put_back_double(doubles, i * 0.37);
+
+    puts(line);
+    fprintf(stdout, "show_list() format of %d nodes to /dev/null\n", LIST_SIZE);
+    puts(line);
+
+    for(int i = 0; i < 2; i++) {
+        const list_t *dumped = i ? doubles : linked;
+        double plain = bench_dump(dumped, false);
+        double buffered = bench_dump(dumped, true);
+        fprintf(stdout, "%-8s fprintf %8.1f ns/node, format_list %8.1f ns/node %8.2fx\n",
+            i ? "DOUBLE" : "INTEGER", plain, buffered, plain / buffered);
+    }
+    doubles = destroy_list(doubles);
+
+
+    /*----------------------------------------------------------------------------------*/
+    puts(line);
+    fprintf(stdout, "save + load of %d INTEGER nodes through a temporary file (ns/node)\n", LIST_SIZE);
+    puts(line);
+
+    double text_save, text_load, binary_save, binary_load;
+    bench_serial(linked, &text_save, &text_load, false);
+    bench_serial(linked, &binary_save, &binary_load, true);
+    fprintf(stdout, "%-8s %10s %10s\n", "", "save", "load");
+    fprintf(stdout, "%-8s %10.1f %10.1f\n", "text", text_save, text_load);
+    fprintf(stdout, "%-8s %10.1f %10.1f %8.2fx\n", "binary", binary_save, binary_load,
+        (text_save + text_load) / (binary_save + binary_load));
+
+
+#ifdef GENLIST_PERSIST
+    /*----------------------------------------------------------------------------------*/
+    puts(line);
+    fprintf(stdout, "cold start of %d INTEGER nodes, until the last one is read (us)\n", LIST_SIZE);
+    puts(line);
+
+    double load_us, map_us;
+    bench_startup(linked, &load_us, &map_us);
+    fprintf(stdout, "%-16s %12.1f\n", "list_load", load_us);
+    fprintf(stdout, "%-16s %12.1f %8.0fx\n", "open_plist", map_us, load_us / map_us);
+#endif
+
+
+    /*----------------------------------------------------------------------------------*/
+    puts(line);
+    fprintf(stdout, "put_back / pop_front, N producers + N consumers, %d values each (Mvalues/s)\n", THREAD_ITEMS);
+    puts(line);
+    fprintf(stdout, "%-8s %14s %14s %14s\n", "N", "global mutex", "head+tail lock", "lock-free");
+
+    for(int pairs = 1; pairs <= MAX_PAIRS; pairs *= 2) {
+        double locked = bench_queue(QUEUE_MUTEX, pairs);
+        double concurrent = bench_queue(QUEUE_CLIST, pairs);
+        double lockfree = bench_queue(QUEUE_LFDEQUE, pairs);
+        fprintf(stdout, "%-8d %14.2f %14.2f %14.2f\n", pairs, locked, concurrent, lockfree);
+    }
+
+
+    /*----------------------------------------------------------------------------------*/
+    linked = destroy_list(linked);
+    unrolled = destroy_list(unrolled);
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include "genlist.h"
+#include <stdlib.h>
+
+
+
+/*Compaction: after a long run of insertions and deletions in the middle of a list, its nodes are
+scattered over the slabs of the pool, and every traversal jumps from one cache line to another.
+Compaction copies the nodes, in list order, into one new slab, gives the old ones back to the pool,
+then deallocates every slab left with free nodes only. It runs at once, or in steps of a few nodes,
+with the list usable between two steps.
+Every step moves nodes: the cursors and node pointers held by the client don't follow them.*/
+
+
+
+/*------------START A COMPACTION: ONE SLAB FOR EVERY NODE OF THE LIST------------*/
+static status_t compact_start(list_t *list)
+{
+    list_compaction_t *compaction = (list_compaction_t*) xmalloc(sizeof(list_compaction_t));
+    if(!compaction)
+        return (MEMORY_ERROR);
+
+    compaction->slab = pool_slab(list_pool(list), list->length);
+    if(!compaction->slab) {
+        free(compaction);
+        return (MEMORY_ERROR);
+    }
+    compaction->used = 0;
+    compaction->next = list->head.next;
+
+    list->compaction = compaction;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------MOVE ONE NODE TO ITS NEW ADDRESS, IN PLACE IN THE LIST------------*/
+static void compact_node(list_t *list, node_t *node, node_t *moved)
+{
+    /* the index and the towers point to nodes: make them follow, while the old node is still linked. */
+    if(list->index)
+        index_move(list, node, moved);
+    if(list->order)
+        order_move(list, node, moved);
+
+    *moved = *node;
+    moved->prev->next = moved;
+    moved->next->prev = moved;
+
+    pool_free(list_pool(list), node);
+}
+
+
+
+/*------------END THE COMPACTION IN PROGRESS (the nodes moved so far stay moved)------------*/
+void compact_stop(list_t *list)
+{
+    list_compaction_t *compaction = list->compaction;
+    if(!compaction)
+        return;
+
+    /* nodes of the slab not needed (the list got shorter meanwhile) become free nodes. */
+    pool_t *pool = list_pool(list);
+    for(len_t i = compaction->slab->count; i > compaction->used; i--)
+        pool_free(pool, &compaction->slab->nodes[i - 1]);
+
+    free(compaction);
+    list->compaction = NULL;
+}
+
+
+
+/*------------MOVE UP TO 'budget' NODES (LIST_IN_PROGRESS: call again later, SUCCESS: done)------------*/
+status_t list_compact_step(list_t *list, const len_t budget)
+{
+    if(!list)
+        return (INVALID_DATA);
+
+    /* unrolled lists have no nodes to move. */
+    if(list->backend != LINKED_LIST)
+        return (LIST_UNSUPPORTED);
+
+    if(!list->compaction) {
+        if(isEmpty(list))
+            return (SUCCESS);
+
+        status_t status = compact_start(list);
+        if(status != SUCCESS)
+            return (status);
+    }
+
+    /* nodes inserted after the start may not all fit in the slab: those stay where they are. */
+    list_compaction_t *compaction = list->compaction;
+    for(len_t steps = 0; steps < budget && compaction->next != &list->head &&
+        compaction->used < compaction->slab->count; steps++) {
+        node_t *node = compaction->next;
+        compaction->next = node->next;
+
+        /* an owned node and its data are one allocation: it is not moved. */
+        if(node->storage != STORE_OWNED)
+            compact_node(list, node, &compaction->slab->nodes[compaction->used++]);
+    }
+
+    if(compaction->next != &list->head && compaction->used < compaction->slab->count)
+        return (LIST_IN_PROGRESS);
+
+    compact_stop(list);
+    pool_trim(list_pool(list));
+    list_set_jumps(list);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------COMPACT THE WHOLE LIST AT ONCE------------*/
+status_t list_compact(list_t *list)
+{
+    return list_compact_step(list, (len_t)-1);
+}
@@ -0,0 +1,328 @@
+#include "genlist.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <pthread.h>
+
+
+
+/*Concurrent list: a two-lock queue.
+The list always starts with a dummy node. Producers lock only the tail and consumers lock only the head,
+so 'put_back' and 'pop_front' running on different threads never wait for each other.
+The two sides share one pointer, the 'next' of the last node, which is read and written atomically.
+Nodes come from a slab pool owned by the producer side. Consumers push the nodes they free on a lock-free stack,
+which producers take back whole when the pool runs dry: no malloc() nor free() per node.*/
+
+
+
+/*------------CONCURRENT LIST DESCRIPTOR------------*/
+struct Concurrent_List {
+    pthread_mutex_t head_lock;                  // consumers: front of the list.
+    struct List_Node *head;                     // dummy node, the first data node is head->next.
+    char head_pad[CACHE_LINE_SIZE];             // keep both locks on their own cache lines.
+    pthread_mutex_t tail_lock;                  // producers: back of the list.
+    struct List_Node *tail;                     // last node, the dummy node when empty.
+    struct Node_Pool pool;                      // nodes are taken from here under the tail lock.
+    char tail_pad[CACHE_LINE_SIZE];
+    struct List_Node *returned;                 // popped nodes, a stack the producers take back whole.
+    long unsigned int length;                   // updated atomically.
+    int (*compare)(const void*, const void*);   // STRUCTURE comparator, NULL: byte-wise.
+};
+
+
+
+/*------------ATOMIC ACCESS TO THE LINK SHARED BY BOTH ENDS------------*/
+static node_t* load_next(node_t *node)
+{
+    return __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+}
+
+static void store_next(node_t *node, node_t *next)
+{
+    __atomic_store_n(&node->next, next, __ATOMIC_RELEASE);
+}
+
+
+
+/*------------TAKE ONE NODE FROM THE POOL (tail lock held)------------*/
+static node_t* alloc_node(clist_t *list)
+{
+    /* recycle the popped nodes before growing the pool. */
+    if(!list->pool.free_nodes) {
+        node_t *node = __atomic_exchange_n(&list->returned, NULL, __ATOMIC_ACQUIRE);
+        while(node) {
+            node_t *next = node->next;
+            pool_free(&list->pool, node);
+            node = next;
+        }
+    }
+
+    return pool_alloc(&list->pool);
+}
+
+
+
+/*------------GIVE ONE POPPED NODE BACK (any thread, no lock)------------*/
+static void return_node(clist_t *list, node_t *node)
+{
+    /* producers only ever take the whole stack, so a plain CAS push is free of ABA. */
+    node_t *top = __atomic_load_n(&list->returned, __ATOMIC_RELAXED);
+    do {
+        node->next = top;
+    } while(!__atomic_compare_exchange_n(&list->returned, &top, node, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+
+
+/*------------CREATE ONE UNLINKED NODE------------*/
+static node_t* create_clist_node(clist_t *list, void *data, const type_t type, const storage_t storage)
+{
+    pthread_mutex_lock(&list->tail_lock);
+    node_t *newNode = alloc_node(list);
+    pthread_mutex_unlock(&list->tail_lock);
+
+    if(!newNode)
+        return (NULL);
+
+    newNode->data = data;
+    newNode->type = type;
+    newNode->storage = storage;
+    newNode->type_id = 0;
+    newNode->hash_tag = 0;
+    newNode->next = newNode->prev = NULL;
+
+    return (newNode);
+}
+
+
+
+/*------------CREATE AN EMPTY CONCURRENT LIST------------*/
+clist_t* create_clist(compare_t compare)
+{
+    clist_t *list = (clist_t*) xmalloc(sizeof(clist_t));
+    if(!list)
+        return (NULL);
+
+    pthread_mutex_init(&list->head_lock, NULL);
+    pthread_mutex_init(&list->tail_lock, NULL);
+    list->pool.free_nodes = NULL;
+    list->pool.slabs = NULL;
+    list->pool.payloads = NULL;
+    list->pool.capacity = list->pool.available = 0;
+    list->pool.references = 1;
+    list->pool.forward = NULL;
+    list->returned = NULL;
+
+    list->head = list->tail = create_clist_node(list, NULL, NULL_DATA, STORE_REFERENCE);
+    if(!list->head) {
+        destroy_clist(list);
+        return (NULL);
+    }
+    list->length = 0;
+    list->compare = compare;
+
+    return (list);
+}
+
+
+
+/*------------LINK A NODE AFTER THE LAST ONE (tail lock held)------------*/
+static void link_back(clist_t *list, node_t *newNode)
+{
+    store_next(list->tail, newNode);
+    list->tail = newNode;
+    __atomic_fetch_add(&list->length, 1, __ATOMIC_RELAXED);
+}
+
+
+
+/*------------INSERT NODE AT BACK (takes the tail lock only)------------*/
+static status_t put_back_value(clist_t *list, const value_t value, const type_t type, const storage_t storage)
+{
+    pthread_mutex_lock(&list->tail_lock);
+
+    node_t *newNode = alloc_node(list);
+    if(!newNode) {
+        pthread_mutex_unlock(&list->tail_lock);
+        return (MEMORY_ERROR);
+    }
+    newNode->double_value = value.double_value;
+    newNode->type = type;
+    newNode->storage = storage;
+    newNode->type_id = 0;
+    newNode->hash_tag = 0;
+    newNode->next = newNode->prev = NULL;
+
+    link_back(list, newNode);
+
+    pthread_mutex_unlock(&list->tail_lock);
+
+    return (SUCCESS);
+}
+
+status_t clist_put_back(clist_t *list, void *data, const type_t type)
+{
+    if(!list || !data || type < INTEGER || type > STRUCTURE)
+        return (INVALID_DATA);
+
+    value_t value;
+    memset(&value, 0, sizeof(value));
+    value.data = data;
+
+    return put_back_value(list, value, type, STORE_REFERENCE);
+}
+
+status_t clist_put_back_int(clist_t *list, const int value)
+{
+    if(!list)
+        return (INVALID_DATA);
+
+    value_t element;
+    memset(&element, 0, sizeof(element));
+    element.int_value = value;
+
+    return put_back_value(list, element, INTEGER, STORE_INLINE);
+}
+
+
+
+/*------------INSERT NODE AT FRONT (head lock, and tail lock when the list is empty)------------*/
+status_t clist_put_front(clist_t *list, void *data, const type_t type)
+{
+    if(!list || !data || type < INTEGER || type > STRUCTURE)
+        return (INVALID_DATA);
+
+    node_t *newNode = create_clist_node(list, data, type, STORE_REFERENCE);
+    if(!newNode)
+        return (MEMORY_ERROR);
+
+    pthread_mutex_lock(&list->head_lock);
+
+    /* on an empty list the dummy node is also the tail: producers must be kept out.
+    Locks are always taken head first, so this can't deadlock. */
+    if(!load_next(list->head)) {
+        pthread_mutex_lock(&list->tail_lock);
+        if(list->tail == list->head) {
+            link_back(list, newNode);
+            pthread_mutex_unlock(&list->tail_lock);
+            pthread_mutex_unlock(&list->head_lock);
+            return (SUCCESS);
+        }
+        pthread_mutex_unlock(&list->tail_lock);
+    }
+
+    newNode->next = load_next(list->head);
+    store_next(list->head, newNode);
+    __atomic_fetch_add(&list->length, 1, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&list->head_lock);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------DELETE NODE AT FRONT (takes the head lock only), ITS CONTENT GOES TO 'out' (may be NULL)------------*/
+status_t clist_pop_front(clist_t *list, node_t *out)
+{
+    if(!list)
+        return (INVALID_DATA);
+
+    pthread_mutex_lock(&list->head_lock);
+
+    node_t *dummy = list->head;
+    node_t *first = load_next(dummy);
+    if(!first) {
+        pthread_mutex_unlock(&list->head_lock);
+        return (LIST_EMPTY);
+    }
+
+    /* the first node becomes the dummy node: the tail pointer never has to change here. */
+    if(out) {
+        out->double_value = first->double_value;
+        out->type = first->type;
+        out->storage = first->storage;
+        out->type_id = first->type_id;
+        out->hash_tag = first->hash_tag;
+        out->next = out->prev = NULL;
+    }
+    first->data = NULL;
+    first->type = NULL_DATA;
+    first->storage = STORE_REFERENCE;
+    list->head = first;
+    __atomic_fetch_sub(&list->length, 1, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&list->head_lock);
+
+    return_node(list, dummy);
+    return (SUCCESS);
+}
+
+
+
+/*------------COMPARE ONE NODE WITH THE GIVEN DATA------------*/
+static bool_t clist_match(const clist_t *list, const node_t *node, const void *data, const type_t type)
+{
+    if(node->type != type)
+        return (false);
+
+    if(type != STRUCTURE)
+        return match_data(NULL, node, data, type);
+
+    if(list->compare)
+        return (list->compare(node->data, data) == 0);
+    return (memcmp(node->data, data, STRUCTURE_SIZE) == 0);
+}
+
+
+
+/*------------SEARCH THE DATA (takes the head lock only)------------*/
+status_t clist_contains(clist_t *list, const void *data, const type_t type)
+{
+    if(!list || !data)
+        return (INVALID_DATA);
+
+    /* nodes are only freed under the head lock and producers only append, so the scan is safe. */
+    pthread_mutex_lock(&list->head_lock);
+
+    status_t status = FALSE;
+    for(node_t *current = load_next(list->head); current; current = load_next(current)) {
+        if(clist_match(list, current, data, type)) {
+            status = TRUE;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&list->head_lock);
+
+    return (status);
+}
+
+
+
+/*------------NUMBER OF DATA NODES (a snapshot while other threads run)------------*/
+len_t clist_length(const clist_t *list)
+{
+    if(!list)
+        return (0);
+
+    return __atomic_load_n(&list->length, __ATOMIC_RELAXED);
+}
+
+
+
+/*------------DEALLOCATE THE ENTIRE LIST (no other thread may use it anymore)------------*/
+clist_t* destroy_clist(clist_t *list)
+{
+    if(!list)
+        return (NULL);
+
+    /* every node, linked or returned, lives in the pool slabs. */
+    pool_release(&list->pool);
+
+    pthread_mutex_destroy(&list->head_lock);
+    pthread_mutex_destroy(&list->tail_lock);
+    free(list);
+
+    return (NULL);
+}
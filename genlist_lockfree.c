@@ -0,0 +1,520 @@
+#include "genlist.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <pthread.h>
+
+
+
+/*Lock-free deque: M. M. Michael, "CAS-based lock-free algorithm for shared deques" (2003).
+The whole deque is described by one 64-bit anchor holding the leftmost node, the rightmost node and a status.
+A push swings the anchor to the new node in one CAS and leaves the anchor "unstable" (LPUSH / RPUSH)
+until the neighbour link is fixed: any thread finding an unstable anchor finishes that work first.
+Nodes live in one array and are addressed by 31-bit indices, so the anchor fits one CAS.
+Popped nodes are not reused while a hazard pointer of another thread still points to them.*/
+
+
+
+/*------------DEQUE NODES, HAZARD RECORDS AND DESCRIPTOR------------*/
+struct Deque_Node {
+    union {
+        void *data;
+        int int_value;
+        double double_value;
+        char char_value;
+    };
+    enum Data_Type type;
+    unsigned char storage;
+    unsigned int left;                          // neighbour indices, updated atomically.
+    unsigned int right;
+    unsigned int next_free;                     // free stack link.
+};
+
+struct Hazard_Record {
+    unsigned int hazards[DEQUE_HAZARDS];        // nodes this thread is reading, 0: none.
+    int active;                                 // owned by a thread.
+    unsigned int retired_count;
+    unsigned int retired[DEQUE_RETIRE_LIMIT];   // popped nodes waiting for no hazard to point to them.
+};
+
+struct Lockfree_Deque {
+    unsigned long long anchor;                  // left index | right index << 31 | status << 62.
+    char anchor_pad[CACHE_LINE_SIZE];
+    unsigned long long free_top;                // free stack: index | tag << 32.
+    char free_pad[CACHE_LINE_SIZE];
+    struct Deque_Node *nodes;                   // nodes[0] is never used.
+    long unsigned int node_count;
+    struct Hazard_Record *records;              // DEQUE_MAX_THREADS records.
+    pthread_key_t record_key;                   // record of the calling thread.
+};
+
+
+
+/*------------ANCHOR ENCODING------------*/
+#define INDEX_MASK      0x7fffffffULL
+#define DEQUE_STABLE    0ULL
+#define DEQUE_RPUSH     1ULL
+#define DEQUE_LPUSH     2ULL
+
+static unsigned long long make_anchor(const unsigned int left, const unsigned int right, const unsigned long long status)
+{
+    return (unsigned long long)left | ((unsigned long long)right << 31) | (status << 62);
+}
+
+static unsigned int anchor_left(const unsigned long long anchor)
+{
+    return (unsigned int)(anchor & INDEX_MASK);
+}
+
+static unsigned int anchor_right(const unsigned long long anchor)
+{
+    return (unsigned int)((anchor >> 31) & INDEX_MASK);
+}
+
+static unsigned long long anchor_status(const unsigned long long anchor)
+{
+    return (anchor >> 62);
+}
+
+
+
+/*------------ATOMIC ACCESS (sequentially consistent: hazard pointers need store -> load order)------------*/
+static unsigned long long load_anchor(lfdeque_t *deque)
+{
+    return __atomic_load_n(&deque->anchor, __ATOMIC_SEQ_CST);
+}
+
+static bool_t cas_anchor(lfdeque_t *deque, unsigned long long expected, const unsigned long long desired)
+{
+    return __atomic_compare_exchange_n(&deque->anchor, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+static unsigned int load_link(const unsigned int *link)
+{
+    return __atomic_load_n(link, __ATOMIC_SEQ_CST);
+}
+
+static void store_link(unsigned int *link, const unsigned int index)
+{
+    __atomic_store_n(link, index, __ATOMIC_SEQ_CST);
+}
+
+
+
+/*------------FREE NODE STACK (the tag changes on every update: no ABA)------------*/
+static void free_push(lfdeque_t *deque, const unsigned int index)
+{
+    unsigned long long top = __atomic_load_n(&deque->free_top, __ATOMIC_ACQUIRE);
+    unsigned long long next;
+
+    do {
+        __atomic_store_n(&deque->nodes[index].next_free, (unsigned int)top, __ATOMIC_RELAXED);
+        next = (((top >> 32) + 1) << 32) | index;
+    } while(!__atomic_compare_exchange_n(&deque->free_top, &top, next, true, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE));
+}
+
+static unsigned int free_pop(lfdeque_t *deque)
+{
+    unsigned long long top = __atomic_load_n(&deque->free_top, __ATOMIC_ACQUIRE);
+    unsigned long long next;
+    unsigned int index;
+
+    do {
+        index = (unsigned int)top;
+        if(!index)
+            return (0);
+        /* the node may be taken meanwhile: then the tag has changed and the CAS fails. */
+        next = (((top >> 32) + 1) << 32) | __atomic_load_n(&deque->nodes[index].next_free, __ATOMIC_RELAXED);
+    } while(!__atomic_compare_exchange_n(&deque->free_top, &top, next, true, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+    return (index);
+}
+
+
+
+/*------------HAZARD RECORD OF THE CALLING THREAD (NULL: DEQUE_MAX_THREADS already in use)------------*/
+static struct Hazard_Record* thread_record(lfdeque_t *deque)
+{
+    struct Hazard_Record *record = pthread_getspecific(deque->record_key);
+    if(record)
+        return (record);
+
+    for(int i = 0; i < DEQUE_MAX_THREADS; i++) {
+        int expected = 0;
+        if(__atomic_compare_exchange_n(&deque->records[i].active, &expected, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            pthread_setspecific(deque->record_key, &deque->records[i]);
+            return (&deque->records[i]);
+        }
+    }
+
+    return (NULL);
+}
+
+/* thread exit: the record (and the nodes it still retires) goes to the next thread. */
+static void release_record(void *arg)
+{
+    struct Hazard_Record *record = arg;
+
+    for(int i = 0; i < DEQUE_HAZARDS; i++)
+        __atomic_store_n(&record->hazards[i], 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&record->active, 0, __ATOMIC_RELEASE);
+}
+
+static void protect(struct Hazard_Record *record, const int slot, const unsigned int index)
+{
+    __atomic_store_n(&record->hazards[slot], index, __ATOMIC_SEQ_CST);
+}
+
+static void unprotect(struct Hazard_Record *record)
+{
+    for(int i = 0; i < DEQUE_HAZARDS; i++)
+        __atomic_store_n(&record->hazards[i], 0, __ATOMIC_RELEASE);
+}
+
+
+
+/*------------FREE EVERY RETIRED NODE NO HAZARD POINTER POINTS TO------------*/
+static void scan_retired(lfdeque_t *deque, struct Hazard_Record *record)
+{
+    unsigned int hazards[DEQUE_MAX_THREADS * DEQUE_HAZARDS];
+    int hazard_count = 0;
+
+    for(int i = 0; i < DEQUE_MAX_THREADS; i++) {
+        for(int j = 0; j < DEQUE_HAZARDS; j++) {
+            unsigned int index = __atomic_load_n(&deque->records[i].hazards[j], __ATOMIC_SEQ_CST);
+            if(index)
+                hazards[hazard_count++] = index;
+        }
+    }
+
+    /* at most DEQUE_MAX_THREADS * DEQUE_HAZARDS nodes stay retired: less than the limit. */
+    unsigned int kept = 0;
+    for(unsigned int i = 0; i < record->retired_count; i++) {
+        unsigned int index = record->retired[i];
+        bool_t hazardous = false;
+        for(int j = 0; j < hazard_count && !hazardous; j++)
+            hazardous = (hazards[j] == index);
+
+        if(hazardous)
+            record->retired[kept++] = index;
+        else
+            free_push(deque, index);
+    }
+    record->retired_count = kept;
+}
+
+static void retire_node(lfdeque_t *deque, struct Hazard_Record *record, const unsigned int index)
+{
+    record->retired[record->retired_count++] = index;
+    if(record->retired_count == DEQUE_RETIRE_LIMIT)
+        scan_retired(deque, record);
+}
+
+static unsigned int alloc_node(lfdeque_t *deque, struct Hazard_Record *record)
+{
+    unsigned int index = free_pop(deque);
+    if(!index && record->retired_count) {
+        scan_retired(deque, record);
+        index = free_pop(deque);
+    }
+
+    return (index);
+}
+
+
+
+/*------------CREATE AN EMPTY DEQUE HOLDING AT LEAST 'capacity' NODES------------*/
+lfdeque_t* create_lfdeque(const len_t capacity)
+{
+    /* every thread may hold up to DEQUE_RETIRE_LIMIT popped nodes before reusing them. */
+    len_t node_count = capacity + (len_t)DEQUE_MAX_THREADS * DEQUE_RETIRE_LIMIT + 1;
+    if(!capacity || node_count > INDEX_MASK)
+        return (NULL);
+
+    lfdeque_t *deque = (lfdeque_t*) xmalloc(sizeof(lfdeque_t));
+    if(!deque)
+        return (NULL);
+
+    deque->nodes = (struct Deque_Node*) xmalloc(node_count * sizeof(struct Deque_Node));
+    deque->records = (struct Hazard_Record*) xmalloc(DEQUE_MAX_THREADS * sizeof(struct Hazard_Record));
+    if(!deque->nodes || !deque->records || pthread_key_create(&deque->record_key, release_record) != 0) {
+        free(deque->nodes);
+        free(deque->records);
+        free(deque);
+        return (NULL);
+    }
+
+    memset(deque->records, 0, DEQUE_MAX_THREADS * sizeof(struct Hazard_Record));
+
+    /* nodes 1 .. node_count-1 all start on the free stack. */
+    for(len_t i = 1; i < node_count; i++)
+        deque->nodes[i].next_free = (i + 1 < node_count) ? (unsigned int)(i + 1) : 0;
+
+    deque->node_count = node_count;
+    deque->free_top = 1;
+    deque->anchor = make_anchor(0, 0, DEQUE_STABLE);
+
+    return (deque);
+}
+
+
+
+/*------------FINISH THE PUSH RECORDED IN AN UNSTABLE ANCHOR------------*/
+static void stabilize_right(lfdeque_t *deque, struct Hazard_Record *record, const unsigned long long anchor)
+{
+    unsigned int right = anchor_right(anchor);
+    protect(record, 0, right);
+    if(load_anchor(deque) != anchor)
+        return;
+
+    unsigned int previous = load_link(&deque->nodes[right].left);
+    protect(record, 1, previous);
+    if(load_anchor(deque) != anchor)
+        return;
+
+    /* link the old rightmost node to the new one, then mark the anchor stable. */
+    unsigned int previous_next = load_link(&deque->nodes[previous].right);
+    if(previous_next != right) {
+        if(load_anchor(deque) != anchor)
+            return;
+        if(!__atomic_compare_exchange_n(&deque->nodes[previous].right, &previous_next, right, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+            return;
+    }
+
+    cas_anchor(deque, anchor, make_anchor(anchor_left(anchor), right, DEQUE_STABLE));
+}
+
+static void stabilize_left(lfdeque_t *deque, struct Hazard_Record *record, const unsigned long long anchor)
+{
+    unsigned int left = anchor_left(anchor);
+    protect(record, 0, left);
+    if(load_anchor(deque) != anchor)
+        return;
+
+    unsigned int previous = load_link(&deque->nodes[left].right);
+    protect(record, 1, previous);
+    if(load_anchor(deque) != anchor)
+        return;
+
+    unsigned int previous_next = load_link(&deque->nodes[previous].left);
+    if(previous_next != left) {
+        if(load_anchor(deque) != anchor)
+            return;
+        if(!__atomic_compare_exchange_n(&deque->nodes[previous].left, &previous_next, left, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+            return;
+    }
+
+    cas_anchor(deque, anchor, make_anchor(left, anchor_right(anchor), DEQUE_STABLE));
+}
+
+static void stabilize(lfdeque_t *deque, struct Hazard_Record *record, const unsigned long long anchor)
+{
+    if(anchor_status(anchor) == DEQUE_RPUSH)
+        stabilize_right(deque, record, anchor);
+    else
+        stabilize_left(deque, record, anchor);
+}
+
+
+
+/*------------INSERT ONE VALUE AT THE GIVEN END------------*/
+static status_t push_value(lfdeque_t *deque, const value_t value, const type_t type, const storage_t storage, const bool_t front)
+{
+    struct Hazard_Record *record = thread_record(deque);
+    if(!record)
+        return (LIST_UNSUPPORTED);
+
+    unsigned int index = alloc_node(deque, record);
+    if(!index)
+        return (MEMORY_ERROR);
+
+    struct Deque_Node *node = &deque->nodes[index];
+    node->double_value = value.double_value;
+    node->type = type;
+    node->storage = storage;
+
+    while(true) {
+        unsigned long long anchor = load_anchor(deque);
+        unsigned int left = anchor_left(anchor);
+        unsigned int right = anchor_right(anchor);
+
+        if(!right) {
+            store_link(&node->left, 0);
+            store_link(&node->right, 0);
+            if(cas_anchor(deque, anchor, make_anchor(index, index, DEQUE_STABLE)))
+                break;
+        } else if(anchor_status(anchor) == DEQUE_STABLE) {
+            unsigned long long pushed;
+            if(front) {
+                store_link(&node->right, left);
+                pushed = make_anchor(index, right, DEQUE_LPUSH);
+            } else {
+                store_link(&node->left, right);
+                pushed = make_anchor(left, index, DEQUE_RPUSH);
+            }
+            if(cas_anchor(deque, anchor, pushed)) {
+                stabilize(deque, record, pushed);
+                break;
+            }
+        } else {
+            stabilize(deque, record, anchor);
+        }
+    }
+
+    unprotect(record);
+    return (SUCCESS);
+}
+
+status_t lfdeque_put_front(lfdeque_t *deque, void *data, const type_t type)
+{
+    if(!deque || !data || type < INTEGER || type > STRUCTURE)
+        return (INVALID_DATA);
+
+    value_t value;
+    memset(&value, 0, sizeof(value));
+    value.data = data;
+
+    return push_value(deque, value, type, STORE_REFERENCE, true);
+}
+
+status_t lfdeque_put_back(lfdeque_t *deque, void *data, const type_t type)
+{
+    if(!deque || !data || type < INTEGER || type > STRUCTURE)
+        return (INVALID_DATA);
+
+    value_t value;
+    memset(&value, 0, sizeof(value));
+    value.data = data;
+
+    return push_value(deque, value, type, STORE_REFERENCE, false);
+}
+
+status_t lfdeque_put_front_int(lfdeque_t *deque, const int value)
+{
+    if(!deque)
+        return (INVALID_DATA);
+
+    value_t element;
+    memset(&element, 0, sizeof(element));
+    element.int_value = value;
+
+    return push_value(deque, element, INTEGER, STORE_INLINE, true);
+}
+
+status_t lfdeque_put_back_int(lfdeque_t *deque, const int value)
+{
+    if(!deque)
+        return (INVALID_DATA);
+
+    value_t element;
+    memset(&element, 0, sizeof(element));
+    element.int_value = value;
+
+    return push_value(deque, element, INTEGER, STORE_INLINE, false);
+}
+
+
+
+/*------------DELETE ONE NODE AT THE GIVEN END, ITS CONTENT GOES TO 'out' (may be NULL)------------*/
+static status_t pop_value(lfdeque_t *deque, node_t *out, const bool_t front)
+{
+    struct Hazard_Record *record = thread_record(deque);
+    if(!record)
+        return (LIST_UNSUPPORTED);
+
+    unsigned int index;
+
+    while(true) {
+        unsigned long long anchor = load_anchor(deque);
+        unsigned int left = anchor_left(anchor);
+        unsigned int right = anchor_right(anchor);
+
+        if(!right) {
+            unprotect(record);
+            return (LIST_EMPTY);
+        }
+
+        index = front ? left : right;
+
+        if(left == right) {
+            protect(record, 0, index);
+            if(load_anchor(deque) != anchor)
+                continue;
+            if(cas_anchor(deque, anchor, make_anchor(0, 0, DEQUE_STABLE)))
+                break;
+        } else if(anchor_status(anchor) == DEQUE_STABLE) {
+            /* the hazard pointer keeps the node from being reused while its link is read. */
+            protect(record, 0, index);
+            if(load_anchor(deque) != anchor)
+                continue;
+            if(front) {
+                unsigned int next = load_link(&deque->nodes[index].right);
+                if(cas_anchor(deque, anchor, make_anchor(next, right, DEQUE_STABLE)))
+                    break;
+            } else {
+                unsigned int previous = load_link(&deque->nodes[index].left);
+                if(cas_anchor(deque, anchor, make_anchor(left, previous, DEQUE_STABLE)))
+                    break;
+            }
+        } else {
+            stabilize(deque, record, anchor);
+        }
+    }
+
+    struct Deque_Node *node = &deque->nodes[index];
+    if(out) {
+        out->double_value = node->double_value;
+        out->type = node->type;
+        out->storage = node->storage;
+        out->next = out->prev = NULL;
+    }
+
+    unprotect(record);
+    retire_node(deque, record, index);
+
+    return (SUCCESS);
+}
+
+status_t lfdeque_pop_front(lfdeque_t *deque, node_t *out)
+{
+    if(!deque)
+        return (INVALID_DATA);
+
+    return pop_value(deque, out, true);
+}
+
+status_t lfdeque_pop_back(lfdeque_t *deque, node_t *out)
+{
+    if(!deque)
+        return (INVALID_DATA);
+
+    return pop_value(deque, out, false);
+}
+
+
+
+/*------------CHECK THE DEQUE IS EMPTY (a snapshot while other threads run)------------*/
+status_t lfdeque_isEmpty(lfdeque_t *deque)
+{
+    if(!deque)
+        return (TRUE);
+
+    return (anchor_right(load_anchor(deque)) == 0) ? TRUE : FALSE;
+}
+
+
+
+/*------------DEALLOCATE THE DEQUE (no other thread may use it anymore)------------*/
+lfdeque_t* destroy_lfdeque(lfdeque_t *deque)
+{
+    if(!deque)
+        return (NULL);
+
+    /* deleting the key first: exiting threads no longer touch the records. */
+    pthread_key_delete(deque->record_key);
+    free(deque->records);
+    free(deque->nodes);
+    free(deque);
+
+    return (NULL);
+}
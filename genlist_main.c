@@ -9,10 +9,6 @@
 #define MAX_STRING_SIZE 40
 
 
-/* Force 1-byte alignment (no padding) */
-#pragma pack(push, 1)
-
-
 /*------------CLIENT DEFINED STRUCTURE------------*/
 struct CustomStruct {
     char string_data[MAX_STRING_SIZE];
@@ -20,10 +16,6 @@ struct CustomStruct {
 };
 
 
-/* Restore the default alignment settings */
-#pragma pack(pop)
-
-
 /*------------CLIENT DEFINED FUNCTION TO DISPLAY CLIENT DEFINED STRUCTURE------------*/
 void show_struct_data(void *data) {
     // type casting the void* to the custom structure pointer
@@ -34,13 +26,19 @@ void show_struct_data(void *data) {
 }
 
 
-/*------------MAIN FUNCTION------------*/
-int main(void) {
+/*------------CLIENT DEFINED FUNCTION TO COMPARE CLIENT DEFINED STRUCTURE (field by field)------------*/
+int compare_struct_data(const void *first, const void *second) {
+    const struct CustomStruct *a = (const struct CustomStruct*) first;
+    const struct CustomStruct *b = (const struct CustomStruct*) second;
 
-    /* To operate with generic behaviour of the linked list, you must pass the structure to the server side. */
-    export_structure(sizeof(struct CustomStruct));
+    if(a->int_data != b->int_data)
+        return (a->int_data < b->int_data) ? -1 : 1;
+    return strcmp(a->string_data, b->string_data);
+}
 
 
+/*------------MAIN FUNCTION------------*/
+int main(void) {
 
     /*----------------------------------------------------------------------------------*/
     list_t *list = NULL;
@@ -55,6 +53,7 @@ int main(void) {
     char char_data;
     // char string_data[MAX_STRING_SIZE];
     struct CustomStruct customStruct_data;
+    type_t custom_type;
 
 
     const char line[] = "----------------------------------------------------------------";
@@ -74,6 +73,10 @@ int main(void) {
     puts("Creating list");
     list = create_list();
 
+    /* To operate with generic behaviour of the linked list, you must register the structure on the list. */
+    custom_type = register_structure(list, sizeof(struct CustomStruct), &compare_struct_data, NULL, &show_struct_data);
+    assert(custom_type != NULL_DATA);
+
 
 
     /*----------------------------------------------------------------------------------*/
@@ -124,7 +127,7 @@ int main(void) {
     // puts("Enter int data for struct: ");
     strcpy(customStruct_data.string_data, string_data);// fgets(customStruct_data.string_data, MAX_STRING_SIZE, stdin);
     // customStruct_data.string_data[strcspn(customStruct_data.string_data, "\n")] = '\0';
-    status = put_back(list, &customStruct_data, STRUCTURE);
+    status = put_back(list, &customStruct_data, custom_type);
     assert(status == SUCCESS);
 
 
@@ -157,6 +160,17 @@ int main(void) {
 
 
 
+    /*----------------------------------------------------------------------------------*/
+    puts(line);
+    puts("Peek first node (no copy): ");
+    view_t first_view;
+    status = peek_front(list, &first_view);
+    assert(status == SUCCESS);
+    assert(first_view.type == first_node->type && first_view.data == first_node->data);
+    release_node(first_node);
+
+
+
     /*----------------------------------------------------------------------------------*/
     puts(line);
     puts("Fetch last node: ");
@@ -195,7 +209,7 @@ int main(void) {
     /*----------------------------------------------------------------------------------*/
     puts(line);
     fprintf(stdout, "Searching for structure data: {%d, %s}\n", customStruct_data.int_data,customStruct_data.string_data);
-    status = contains_data(list, &customStruct_data, STRUCTURE);
+    status = contains_data(list, &customStruct_data, custom_type);
     assert(status == TRUE);
     if(status == TRUE) {
         puts("Data found.");
@@ -0,0 +1,358 @@
+#include "genlist.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+
+/*Ordered list: the node ring is kept sorted, by the rules of compare_nodes() (type first, then value),
+and a skip list of towers is laid over it. Level 0 is the ring itself, so a tower only exists for
+about one node in four: a search runs down the towers, then walks a few nodes of the ring.
+Every insertion puts its node at the sorted place, after the nodes holding equal data.*/
+
+
+
+/*------------A NODE VIEW OF THE SEARCHED DATA------------*/
+static void key_node(node_t *key, const void *data, const type_t type)
+{
+    key->data = (void*) data;
+    key->type = TYPE_BASE(type);
+    key->type_id = TYPE_ID(type);
+    key->storage = STORE_REFERENCE;
+    key->next = key->prev = NULL;
+}
+
+
+
+/*------------RANDOM TOWER HEIGHT (xorshift), 0: NO TOWER------------*/
+static unsigned int tower_height(list_order_t *order)
+{
+    unsigned long long x = order->seed;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    order->seed = x;
+
+    /* two random bits per level: one tower in four goes one level higher. */
+    unsigned int height = 0;
+    while(height < ORDER_MAX_LEVEL && (x & 3) == 0) {
+        height++;
+        x >>= 2;
+    }
+
+    return (height);
+}
+
+
+
+/*------------DOES 'node' STOP A WALK TOWARD THE KEY ? (after it, or equal when not 'skip_equal')------------*/
+static bool_t stops_at(const list_t *list, const node_t *node, const node_t *key, const bool_t skip_equal)
+{
+    int order = compare_nodes(list, node, key, NULL);
+
+    return (order > 0 || (order == 0 && !skip_equal));
+}
+
+
+
+/*------------FIRST NODE AT OR AFTER THE KEY (after the equal ones when 'skip_equal'), head: none------------*/
+/* 'update' (may be NULL) gets the last tower of each level in use before that node. */
+static node_t* order_bound(const list_t *list, const node_t *key, const bool_t skip_equal, order_tower_t **update)
+{
+    list_order_t *order = list->order;
+    order_tower_t *tower = order->head;
+    len_t steps = 0, comparisons = 0;
+
+    for(unsigned int level = order->levels; level-- > 0; ) {
+        while(tower->next[level] && (comparisons++, !stops_at(list, tower->next[level]->node, key, skip_equal))) {
+            tower = tower->next[level];
+            steps++;
+        }
+        if(update)
+            update[level] = tower;
+    }
+
+    /* a few nodes of the ring are left before the next tower. */
+    node_t *current = tower->node ? tower->node->next : list->head.next;
+    while(current != &list->head && (comparisons++, !stops_at(list, current, key, skip_equal))) {
+        current = current->next;
+        steps++;
+    }
+
+    STATS_COUNT(list, visited, steps);
+    STATS_COUNT(list, comparisons, comparisons);
+
+    return (current);
+}
+
+
+
+/*------------NODE TO INSERT 'node' AFTER, WITH THE TOWERS TO LINK ITS OWN TOWER AFTER------------*/
+node_t* order_position(list_t *list, const node_t *node, order_tower_t **update)
+{
+    return order_bound(list, node, true, update)->prev;
+}
+
+
+
+/*------------GIVE A NEWLY LINKED NODE ITS TOWER (update: from order_position())------------*/
+void order_link(list_t *list, node_t *node, order_tower_t **update)
+{
+    list_order_t *order = list->order;
+    unsigned int height = tower_height(order);
+    if(!height)
+        return;
+
+    /* without a tower the node is still found through the ring: only slower. */
+    order_tower_t *tower = (order_tower_t*) xmalloc(sizeof(order_tower_t) + height * sizeof(order_tower_t*));
+    if(!tower)
+        return;
+    tower->node = node;
+
+    for(unsigned int level = 0; level < height; level++) {
+        order_tower_t *before = (level < order->levels) ? update[level] : order->head;
+        tower->next[level] = before->next[level];
+        before->next[level] = tower;
+    }
+
+    if(height > order->levels)
+        order->levels = height;
+}
+
+
+
+/*------------TOWER OF A LINKED NODE, NULL: NONE ('update' gets the tower before it on each of its levels)------------*/
+static order_tower_t* node_tower(list_t *list, node_t *node, order_tower_t **update)
+{
+    list_order_t *order = list->order;
+    order_tower_t *tower = NULL;
+
+    order_bound(list, node, false, update);
+
+    /* towers of equal data are in insertion order: look for the node's own one among them. */
+    for(unsigned int level = 0; level < order->levels; level++) {
+        order_tower_t *before = update[level];
+        while(before->next[level] && before->next[level]->node != node &&
+            compare_nodes(list, before->next[level]->node, node, NULL) == 0)
+            before = before->next[level];
+
+        if(!before->next[level] || before->next[level]->node != node)
+            break;
+        update[level] = before;
+        tower = before->next[level];
+    }
+
+    return (tower);
+}
+
+
+
+/*------------DROP THE TOWER OF A NODE ABOUT TO BE UNLINKED------------*/
+void order_remove(list_t *list, node_t *node)
+{
+    list_order_t *order = list->order;
+    order_tower_t *update[ORDER_MAX_LEVEL];
+
+    order_tower_t *tower = node_tower(list, node, update);
+    if(!tower)
+        return;
+
+    for(unsigned int level = 0; level < order->levels && update[level]->next[level] == tower; level++)
+        update[level]->next[level] = tower->next[level];
+    free(tower);
+
+    while(order->levels && !order->head->next[order->levels - 1])
+        order->levels--;
+}
+
+
+
+/*------------THE NODE MOVES TO ANOTHER ADDRESS (same data): ITS TOWER FOLLOWS------------*/
+void order_move(list_t *list, node_t *node, node_t *moved)
+{
+    order_tower_t *update[ORDER_MAX_LEVEL];
+
+    order_tower_t *tower = node_tower(list, node, update);
+    if(tower)
+        tower->node = moved;
+}
+
+
+
+/*------------SEARCH THE FIRST NODE HOLDING THE GIVEN DATA------------*/
+node_t* order_find(const list_t *list, const void *data, const type_t type)
+{
+    node_t key;
+    key_node(&key, data, type);
+
+    /* equal for the order is not always equal for match_data() (-0.0 and 0.0): check each one. */
+    for(node_t *current = order_bound(list, &key, false, NULL);
+        current != &list->head && compare_nodes(list, current, &key, NULL) == 0; current = current->next) {
+        if(match_data(list, current, data, type))
+            return (current);
+    }
+
+    return (NULL);
+}
+
+
+
+/*------------DROP EVERY TOWER (the list keeps its order mode)------------*/
+void order_clear(list_t *list)
+{
+    list_order_t *order = list->order;
+    order_tower_t *tower = order->head->next[0];
+
+    while(tower) {
+        order_tower_t *next = tower->next[0];
+        free(tower);
+        tower = next;
+    }
+
+    memset(order->head->next, 0, ORDER_MAX_LEVEL * sizeof(order_tower_t*));
+    order->levels = 0;
+}
+
+
+
+/*------------BUILD THE TOWERS OF A SORTED LIST IN ONE PASS------------*/
+static void order_build(list_t *list)
+{
+    list_order_t *order = list->order;
+    order_tower_t *last[ORDER_MAX_LEVEL];
+
+    for(unsigned int level = 0; level < ORDER_MAX_LEVEL; level++)
+        last[level] = order->head;
+
+    for(node_t *current = list->head.next; current != &list->head; current = current->next) {
+        unsigned int height = tower_height(order);
+        if(!height)
+            continue;
+
+        order_tower_t *tower = (order_tower_t*) xmalloc(sizeof(order_tower_t) + height * sizeof(order_tower_t*));
+        if(!tower)
+            continue;
+        tower->node = current;
+
+        for(unsigned int level = 0; level < height; level++) {
+            tower->next[level] = NULL;
+            last[level]->next[level] = tower;
+            last[level] = tower;
+        }
+        if(height > order->levels)
+            order->levels = height;
+    }
+}
+
+
+
+/*------------TURN THE LIST INTO AN ORDERED LIST (sorts it unless already sorted)------------*/
+status_t enable_order(list_t *list)
+{
+    if(!list)
+        return (INVALID_DATA);
+
+    /* the towers point to nodes: linked lists only. */
+    if(list->backend != LINKED_LIST)
+        return (LIST_UNSUPPORTED);
+
+    if(list->order)
+        return (SUCCESS);
+
+    list_order_t *order = (list_order_t*) xmalloc(sizeof(list_order_t));
+    if(!order)
+        return (MEMORY_ERROR);
+
+    order->head = (order_tower_t*) calloc(1, sizeof(order_tower_t) + ORDER_MAX_LEVEL * sizeof(order_tower_t*));
+    if(!order->head) {
+        free(order);
+        return (MEMORY_ERROR);
+    }
+    order->levels = 0;
+    order->seed = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)(long unsigned int)list;
+
+    /* a list which is already in order is not sorted again. */
+    for(node_t *current = list->head.next; current != &list->head && current->next != &list->head; current = current->next) {
+        if(compare_nodes(list, current, current->next, NULL) > 0) {
+            sort_list(list, NULL);
+            break;
+        }
+    }
+
+    list->order = order;
+    order_build(list);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------BACK TO AN UNORDERED LIST (the nodes stay where they are)------------*/
+status_t disable_order(list_t *list)
+{
+    if(!list)
+        return (INVALID_DATA);
+
+    if(list->order) {
+        order_clear(list);
+        free(list->order->head);
+        free(list->order);
+        list->order = NULL;
+    }
+
+    return (SUCCESS);
+}
+
+
+
+/*------------CURSOR ON THE FIRST ELEMENT >= / > THE DATA (at the end: none)------------*/
+static status_t order_cursor(list_t *list, const void *data, const type_t type, const bool_t skip_equal,
+    list_cursor_t *cursor)
+{
+    if(!list || !data || !cursor)
+        return (INVALID_DATA);
+
+    if(!list->order)
+        return (LIST_UNSUPPORTED);
+
+    node_t key;
+    key_node(&key, data, type);
+
+    cursor->list = list;
+    cursor->node = order_bound(list, &key, skip_equal, NULL);
+
+    return (SUCCESS);
+}
+
+status_t list_lower_bound(list_t *list, const void *data, const type_t type, list_cursor_t *cursor)
+{
+    return order_cursor(list, data, type, false, cursor);
+}
+
+status_t list_upper_bound(list_t *list, const void *data, const type_t type, list_cursor_t *cursor)
+{
+    return order_cursor(list, data, type, true, cursor);
+}
+
+
+
+/*------------ELEMENTS IN [low, high]: FROM 'first' UP TO, NOT INCLUDING, 'end'------------*/
+status_t list_range(list_t *list, const void *low, const void *high, const type_t type,
+    list_cursor_t *first, list_cursor_t *end)
+{
+    status_t status = list_lower_bound(list, low, type, first);
+    if(status != SUCCESS)
+        return (status);
+
+    status = list_upper_bound(list, high, type, end);
+    if(status != SUCCESS)
+        return (status);
+
+    /* high < low: an empty range. */
+    node_t low_key, high_key;
+    key_node(&low_key, low, type);
+    key_node(&high_key, high, type);
+    if(compare_nodes(list, &low_key, &high_key, NULL) > 0)
+        *end = *first;
+
+    return (SUCCESS);
+}
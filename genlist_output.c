@@ -0,0 +1,375 @@
+#include "genlist.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+
+
+
+/*------------OUTPUT BUFFER SIZES------------*/
+#define OUT_FD_BUFFER_SIZE      65536       // flushed to the file descriptor when full.
+#define OUT_MEMORY_MIN_SIZE     256         // memory buffers double from here.
+
+
+
+/*------------WRITE ALL BYTES TO A FILE DESCRIPTOR------------*/
+static status_t write_all(const int fd, const char *bytes, len_t size)
+{
+    while(size > 0) {
+        ssize_t written = write(fd, bytes, size);
+        if(written < 0) {
+            if(errno == EINTR)
+                continue;
+            return (FAILED);
+        }
+        bytes += written;
+        size -= (len_t)written;
+    }
+
+    return (SUCCESS);
+}
+
+
+
+/*------------OPEN AN OUTPUT BUFFER (fd >= 0: flushed to fd, fd < 0: growable memory)------------*/
+status_t out_open(out_buffer_t *out, const int fd)
+{
+    if(!out)
+        return (INVALID_DATA);
+
+    len_t capacity = (fd >= 0) ? OUT_FD_BUFFER_SIZE : OUT_MEMORY_MIN_SIZE;
+    out->data = (char*) xmalloc(capacity);
+    if(!out->data)
+        return (MEMORY_ERROR);
+
+    out->length = 0;
+    out->capacity = capacity;
+    out->fd = fd;
+    out->owned = true;
+    out->status = SUCCESS;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------OUTPUT BUFFER OVER CALLER MEMORY, FLUSHED TO 'fd' (no allocation)------------*/
+static void out_wrap(out_buffer_t *out, char *buffer, const len_t size, const int fd)
+{
+    out->data = buffer;
+    out->length = 0;
+    out->capacity = size;
+    out->fd = fd;
+    out->owned = false;
+    out->status = SUCCESS;
+}
+
+
+
+/*------------WRITE THE BUFFERED BYTES TO THE FILE DESCRIPTOR------------*/
+status_t out_flush(out_buffer_t *out)
+{
+    /* memory buffers keep everything until closed. */
+    if(out->fd < 0 || out->length == 0)
+        return (out->status);
+
+    if(out->status == SUCCESS)
+        out->status = write_all(out->fd, out->data, out->length);
+    out->length = 0;
+
+    return (out->status);
+}
+
+
+
+/*------------FLUSH AND DEALLOCATE THE BUFFER, RETURNS THE FIRST ERROR MET------------*/
+status_t out_close(out_buffer_t *out)
+{
+    if(!out)
+        return (INVALID_DATA);
+
+    status_t status = out_flush(out);
+
+    if(out->owned)
+        free(out->data);
+    out->data = NULL;
+    out->length = out->capacity = 0;
+
+    return (status);
+}
+
+
+
+/*------------APPEND BYTES (errors are kept in out->status)------------*/
+void out_bytes(out_buffer_t *out, const char *bytes, const len_t size)
+{
+    if(out->status != SUCCESS)
+        return;
+
+    if(out->length + size > out->capacity) {
+        if(out->fd >= 0) {
+            /* make room by flushing, blocks bigger than the buffer go straight out. */
+            if(out_flush(out) != SUCCESS)
+                return;
+            if(size > out->capacity) {
+                out->status = write_all(out->fd, bytes, size);
+                return;
+            }
+        } else {
+            len_t capacity = out->capacity;
+            while(out->length + size > capacity)
+                capacity *= 2;
+
+            char *data = (char*) realloc(out->data, capacity);
+            if(!data) {
+                out->status = MEMORY_ERROR;
+                return;
+            }
+            out->data = data;
+            out->capacity = capacity;
+        }
+    }
+
+    memcpy(out->data + out->length, bytes, size);
+    out->length += size;
+}
+
+void out_char(out_buffer_t *out, const char character)
+{
+    /* the common case, room left: one store. */
+    if(out->length < out->capacity && out->status == SUCCESS) {
+        out->data[out->length++] = character;
+        return;
+    }
+
+    out_bytes(out, &character, 1);
+}
+
+void out_string(out_buffer_t *out, const char *string)
+{
+    out_bytes(out, string, strlen(string));
+}
+
+
+
+/*------------APPEND AN INTEGER, AS "%d"------------*/
+void out_int(out_buffer_t *out, const int value)
+{
+    char text[12];
+    int position = sizeof(text);
+    unsigned int magnitude = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+
+    do {
+        text[--position] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while(magnitude);
+
+    if(value < 0)
+        text[--position] = '-';
+
+    out_bytes(out, text + position, sizeof(text) - position);
+}
+
+
+
+/*------------APPEND A DOUBLE, AS "%lf"------------*/
+void out_double(out_buffer_t *out, const double value)
+{
+    char text[32];
+    double magnitude = (value < 0) ? -value : value;
+
+    /* fixed point with 6 decimals, rounded like printf(): exact except close to a tie.
+    Under 1e6 the scaled value is off by less than 1e-4, so only ties need printf(). */
+    if(magnitude < 1e6) {
+        double scaled = magnitude * 1e6;
+        unsigned long long whole = (unsigned long long)scaled;
+        double fraction = scaled - (double)whole;
+
+        if(fraction < 0.499 || fraction > 0.501) {
+            if(fraction > 0.5)
+                whole++;
+
+            int position = sizeof(text);
+            for(int i = 0; i < 6; i++) {
+                text[--position] = (char)('0' + whole % 10);
+                whole /= 10;
+            }
+            text[--position] = '.';
+            do {
+                text[--position] = (char)('0' + whole % 10);
+                whole /= 10;
+            } while(whole);
+
+            // -0.0 and small negative values print as "-0.000000", like printf().
+            if(value < 0 || (value == 0 && 1 / value < 0))
+                text[--position] = '-';
+
+            out_bytes(out, text + position, sizeof(text) - position);
+            return;
+        }
+    }
+
+    /* NaN, infinities, big values and ties. */
+    char *large = text;
+    int size = snprintf(text, sizeof(text), "%lf", value);
+    if(size >= (int)sizeof(text)) {
+        large = (char*) xmalloc(size + 1);
+        if(!large) {
+            out->status = MEMORY_ERROR;
+            return;
+        }
+        snprintf(large, size + 1, "%lf", value);
+    }
+    out_bytes(out, large, size);
+    if(large != text)
+        free(large);
+}
+
+
+
+/*------------RENDER ONE NODE, IN THE FORMAT OF show_data()------------*/
+/* STRUCTURE data: 'format' appends to the buffer, else 'display' prints it on stdout itself. */
+status_t render_data(out_buffer_t *out, const node_t *node, display_t display, format_t format)
+{
+    if(!node || (node->storage == STORE_REFERENCE && !node->data))
+        return (INVALID_DATA);
+
+    const void *data = node_data(node);
+
+    switch(node->type) {
+        case INTEGER:
+            out_char(out, '[');
+            out_int(out, *(const int*)data);
+            out_char(out, ']');
+            break;
+        case DOUBLE:
+            out_char(out, '[');
+            out_double(out, *(const double*)data);
+            out_char(out, ']');
+            break;
+        case CHARACTER:
+            out_char(out, '[');
+            out_char(out, *(const char*)data);
+            out_char(out, ']');
+            break;
+        case STRING:
+            if(node->storage == STORE_INLINE)
+                return (INVALID_TYPE);
+            out_char(out, '[');
+            out_string(out, (const char*)data);
+            out_char(out, ']');
+            break;
+        case STRUCTURE:
+            if(node->storage == STORE_INLINE)
+                return (INVALID_TYPE);
+            out_char(out, '{');
+            if(format) {
+                format(out, node->data);
+            } else if(display) {
+                /* the callback prints through stdio: keep the order of both streams. */
+                out_flush(out);
+                display(node->data);
+                fflush(stdout);
+            }
+            out_char(out, '}');
+            break;
+        default:
+            return (INVALID_TYPE);
+    }
+
+    return (out->status);
+}
+
+
+
+/*------------RENDER THE WHOLE LIST, IN THE FORMAT OF show_list()------------*/
+status_t render_list(const list_t *list, out_buffer_t *out, display_t display, format_t format)
+{
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    if(list->backend == UNROLLED_LIST)
+        return unrolled_render_list(list, out, display, format);
+    if(list->backend == PACKED_LIST)
+        return packed_render_list(list, out, display, format);
+
+    out_string(out, "[START] <-> ");
+    for(node_t *current = list->head.next; current != &list->head; current = current->next) {
+        PREFETCH_AHEAD(current);
+        PREFETCH_DATA(current->next);
+
+        /* registered types bring their own display. */
+        const structure_type_t *info = structure_type(list, node_type(current));
+
+        status_t status = render_data(out, current, (info && info->display) ? info->display : display, format);
+        if(!(status == SUCCESS))
+            return (status);
+
+        out_string(out, " <-> ");
+    }
+    out_string(out, "[END]\n");
+
+    return (out->status);
+}
+
+
+
+/*------------RENDER THE LIST INTO AN OUTPUT BUFFER------------*/
+status_t format_list(const list_t *list, out_buffer_t *out, format_t format)
+{
+    if(!out)
+        return (INVALID_DATA);
+
+    return render_list(list, out, NULL, format);
+}
+
+
+
+/*------------RENDER ONE NODE INTO AN OUTPUT BUFFER------------*/
+status_t format_data(const node_t *node, out_buffer_t *out, format_t format)
+{
+    if(!out)
+        return (INVALID_DATA);
+
+    return render_data(out, node, NULL, format);
+}
+
+
+
+/*------------SHOW LIST NODES ONE BY ONE------------*/
+status_t show_list(const list_t *list, void (*struct_display)(void*))
+{
+    if(isEmpty(list))
+        return (LIST_EMPTY);
+
+    /* the list is rendered in big blocks, written straight to the stdout file descriptor:
+    whatever stdio still holds must go first. */
+    fflush(stdout);
+
+    out_buffer_t out;
+    if(out_open(&out, fileno(stdout)) != SUCCESS)
+        return (MEMORY_ERROR);
+
+    status_t status = render_list(list, &out, struct_display, NULL);
+    status_t closed = out_close(&out);
+
+    return (status == SUCCESS) ? closed : status;
+}
+
+
+
+/*------------SHOW ONE NODE DATA------------*/
+status_t show_data(const node_t *data_node, void (*struct_display)(void*))
+{
+    char text[64];
+    out_buffer_t out;
+
+    fflush(stdout);
+    out_wrap(&out, text, sizeof(text), fileno(stdout));
+
+    status_t status = render_data(&out, data_node, struct_display, NULL);
+    status_t closed = out_close(&out);
+
+    return (status == SUCCESS) ? closed : status;
+}
@@ -0,0 +1,572 @@
+#include "genlist.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+
+/*Packed list: a node is 16 bytes instead of 32. The value (inline, or a data reference) takes 8 bytes,
+and the links are 28-bit indices into the chunks of the list, with the element tag in the bits left over:
+the data type above 'next', the inline flag above 'prev'. Node 0 is the head.
+Chunks never move once full, and only the first one grows (by realloc), so an index stays valid
+for as long as its element is in the list. A list holds at most PACKED_MAX_NODES elements.*/
+
+
+
+#define PACKED_FIRST_CHUNK      64          // nodes of the first chunk of a new list.
+#define PACKED_INLINE_BIT       (1U << 31)
+
+
+
+/*------------NODE AT AN INDEX------------*/
+static packed_node_t* node_at(const packed_pool_t *pool, const unsigned int index)
+{
+    return &pool->chunks[index >> PACKED_CHUNK_BITS][index & (PACKED_CHUNK_SIZE - 1)];
+}
+
+
+
+/*------------LINKS AND TAG OF A NODE------------*/
+static unsigned int next_of(const packed_node_t *node)
+{
+    return (node->next & PACKED_INDEX_MASK);
+}
+
+static unsigned int prev_of(const packed_node_t *node)
+{
+    return (node->prev & PACKED_INDEX_MASK);
+}
+
+static unsigned char tag_of(const packed_node_t *node)
+{
+    return (unsigned char)((node->next >> PACKED_INDEX_BITS) | ((node->prev & PACKED_INLINE_BIT) ? UNROLLED_INLINE : 0));
+}
+
+static void set_next(packed_node_t *node, const unsigned int index)
+{
+    node->next = (node->next & ~PACKED_INDEX_MASK) | index;
+}
+
+static void set_prev(packed_node_t *node, const unsigned int index)
+{
+    node->prev = (node->prev & ~PACKED_INDEX_MASK) | index;
+}
+
+
+
+/*------------ALLOCATE THE POOL OF A LIST, WITH ITS HEAD NODE------------*/
+static status_t start_pool(list_t *list)
+{
+    packed_pool_t *pool = (packed_pool_t*) xmalloc(sizeof(packed_pool_t));
+    if(!pool)
+        return (MEMORY_ERROR);
+
+    pool->chunks = (packed_node_t**) xmalloc(sizeof(packed_node_t*));
+    if(!pool->chunks) {
+        free(pool);
+        return (MEMORY_ERROR);
+    }
+
+    pool->chunks[0] = (packed_node_t*) xmalloc(PACKED_FIRST_CHUNK * sizeof(packed_node_t));
+    if(!pool->chunks[0]) {
+        free(pool->chunks);
+        free(pool);
+        return (MEMORY_ERROR);
+    }
+
+    pool->chunk_count = 1;
+    pool->capacity = PACKED_FIRST_CHUNK;
+    pool->free_nodes = 0;
+
+    /* the head links to itself. */
+    pool->used = 1;
+    pool->chunks[0][0].next = pool->chunks[0][0].prev = 0;
+
+    list->packed = pool;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------MAKE ROOM FOR MORE NODES (node addresses may change, indices don't)------------*/
+static status_t grow_pool(packed_pool_t *pool)
+{
+    if(pool->capacity > PACKED_MAX_NODES)
+        return (MEMORY_ERROR);
+
+    /* the first chunk doubles up to a full chunk: small lists stay small. */
+    if(pool->capacity < PACKED_CHUNK_SIZE) {
+        packed_node_t *chunk = (packed_node_t*) realloc(pool->chunks[0], 2 * pool->capacity * sizeof(packed_node_t));
+        if(!chunk)
+            return (MEMORY_ERROR);
+        pool->chunks[0] = chunk;
+        pool->capacity *= 2;
+        return (SUCCESS);
+    }
+
+    packed_node_t **chunks = (packed_node_t**) realloc(pool->chunks, (pool->chunk_count + 1) * sizeof(packed_node_t*));
+    if(!chunks)
+        return (MEMORY_ERROR);
+    pool->chunks = chunks;
+
+    chunks[pool->chunk_count] = (packed_node_t*) xmalloc(PACKED_CHUNK_SIZE * sizeof(packed_node_t));
+    if(!chunks[pool->chunk_count])
+        return (MEMORY_ERROR);
+
+    pool->chunk_count++;
+    pool->capacity += PACKED_CHUNK_SIZE;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------TAKE ONE NODE (0: out of memory, or the list is full)------------*/
+static unsigned int alloc_node(packed_pool_t *pool)
+{
+    if(pool->free_nodes) {
+        unsigned int index = pool->free_nodes;
+        pool->free_nodes = node_at(pool, index)->next;
+        return (index);
+    }
+
+    if(pool->used == pool->capacity && grow_pool(pool) != SUCCESS)
+        return (0);
+
+    return (pool->used++);
+}
+
+
+
+/*------------INSERT ONE ELEMENT AFTER THE NODE 'prev_index' (0: at the front)------------*/
+static status_t insert_element(list_t *list, const unsigned int prev_index, const value_t value, const unsigned char tag)
+{
+    if(!list->packed && start_pool(list) != SUCCESS)
+        return (MEMORY_ERROR);
+
+    packed_pool_t *pool = list->packed;
+    unsigned int index = alloc_node(pool);
+    if(!index)
+        return (MEMORY_ERROR);
+
+    /* taken after alloc_node(): the first chunk may have moved. */
+    packed_node_t *prev = node_at(pool, prev_index);
+    unsigned int next_index = next_of(prev);
+    packed_node_t *node = node_at(pool, index);
+
+    node->value = value;
+    node->next = ((unsigned int)(tag & ~UNROLLED_INLINE) << PACKED_INDEX_BITS) | next_index;
+    node->prev = ((tag & UNROLLED_INLINE) ? PACKED_INLINE_BIT : 0) | prev_index;
+    set_next(prev, index);
+    set_prev(node_at(pool, next_index), index);
+
+    list->length++;
+    list->stats.inserts++;
+    STATS_GLOBAL(inserts, 1);
+    if(list->length > list->stats.peak_length)
+        list->stats.peak_length = list->length;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------DELETE THE ELEMENT AT 'index'------------*/
+static void delete_element(list_t *list, const unsigned int index)
+{
+    packed_pool_t *pool = list->packed;
+    packed_node_t *node = node_at(pool, index);
+
+    set_next(node_at(pool, prev_of(node)), next_of(node));
+    set_prev(node_at(pool, next_of(node)), prev_of(node));
+
+    node->next = pool->free_nodes;
+    pool->free_nodes = index;
+
+    list->length--;
+    list->stats.removals++;
+    STATS_GLOBAL(removals, 1);
+}
+
+
+
+/*------------VIEW ONE ELEMENT AS A NODE (no allocation)------------*/
+static void element_node(const packed_node_t *element, node_t *node)
+{
+    unsigned char tag = tag_of(element);
+
+    node->double_value = element->value.double_value;
+    node->type = (type_t)(tag & ~UNROLLED_INLINE);
+    node->storage = (tag & UNROLLED_INLINE) ? STORE_INLINE : STORE_REFERENCE;
+    node->type_id = 0;
+    node->hash_tag = 0;
+    node->next = node->prev = node;
+}
+
+
+
+/*------------FIND THE FIRST ELEMENT HOLDING THE GIVEN DATA (0: none)------------*/
+static unsigned int packed_find(const list_t *list, const void * data, const type_t type)
+{
+    const packed_pool_t *pool = list->packed;
+    if(!pool)
+        return (0);
+
+    /* inline values are stored zero-extended to 8 bytes: build the key the same way. */
+    value_t key;
+    memset(&key, 0, sizeof(key));
+    switch(type) {
+        case INTEGER:   memcpy(&key, data, sizeof(int));    break;
+        case DOUBLE:    memcpy(&key, data, sizeof(double)); break;
+        case CHARACTER: memcpy(&key, data, sizeof(char));   break;
+        default:        break;
+    }
+
+    unsigned char inline_tag = (unsigned char)type | UNROLLED_INLINE;
+    node_t element;
+
+    for(unsigned int index = next_of(node_at(pool, 0)); index; ) {
+        const packed_node_t *node = node_at(pool, index);
+        unsigned char tag = tag_of(node);
+
+        /* inline scalars: tag and value bytes, with no node view. */
+        if(tag == inline_tag) {
+            if(memcmp(&node->value, &key, sizeof(value_t)) == 0)
+                return (index);
+        }
+        /* references of the same type: same comparison rules as the linked list. */
+        else if(tag == (unsigned char)type) {
+            element_node(node, &element);
+            if(match_data(list, &element, data, type))
+                return (index);
+        }
+
+        index = next_of(node);
+    }
+
+    return (0);
+}
+
+
+
+/*------------COPY ONE ELEMENT INTO A NEW NODE (as get_* does)------------*/
+static status_t fetch_element(const list_t *list, const unsigned int index, node_t **target_node)
+{
+    node_t element;
+    element_node(node_at(list->packed, index), &element);
+
+    *target_node = copy_node(&element);
+    if(!(*target_node))
+        return (MEMORY_ERROR);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------VIEW ONE ELEMENT (as peek_* does)------------*/
+static status_t view_element(const list_t *list, const unsigned int index, view_t *view)
+{
+    const packed_node_t *node = node_at(list->packed, index);
+    unsigned char tag = tag_of(node);
+
+    view->type = (type_t)(tag & ~UNROLLED_INLINE);
+    view->data = (tag & UNROLLED_INLINE) ? (const void*)&node->value : node->value.data;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------FIRST / LAST ELEMENT, AND THE ONES AROUND AN ELEMENT (0: none)------------*/
+static unsigned int first_element(const list_t *list)
+{
+    return next_of(node_at(list->packed, 0));
+}
+
+static unsigned int last_element(const list_t *list)
+{
+    return prev_of(node_at(list->packed, 0));
+}
+
+static unsigned int next_element(const list_t *list, const unsigned int index)
+{
+    return next_of(node_at(list->packed, index));
+}
+
+static unsigned int prev_element(const list_t *list, const unsigned int index)
+{
+    return prev_of(node_at(list->packed, index));
+}
+
+
+
+/*------------INSERT ONE ELEMENT AT THE FRONT / END------------*/
+status_t packed_put_front(list_t *list, const value_t value, const unsigned char tag)
+{
+    return insert_element(list, 0, value, tag);
+}
+
+status_t packed_put_back(list_t *list, const value_t value, const unsigned char tag)
+{
+    return insert_element(list, list->packed ? last_element(list) : 0, value, tag);
+}
+
+
+
+/*------------INSERT ONE ELEMENT AFTER / BEFORE AN EXISTING ELEMENT------------*/
+status_t packed_put_after(list_t *list, const void * existing_data, const type_t existing_type,
+    const value_t value, const unsigned char tag)
+{
+    unsigned int index = packed_find(list, existing_data, existing_type);
+    if(!index)
+        return (LIST_DATA_NOT_FOUND);
+
+    return insert_element(list, index, value, tag);
+}
+
+status_t packed_put_before(list_t *list, const void * existing_data, const type_t existing_type,
+    const value_t value, const unsigned char tag)
+{
+    unsigned int index = packed_find(list, existing_data, existing_type);
+    if(!index)
+        return (LIST_DATA_NOT_FOUND);
+
+    return insert_element(list, prev_element(list, index), value, tag);
+}
+
+
+
+/*------------REMOVE THE FIRST / LAST ELEMENT------------*/
+status_t packed_pop_front(list_t *list)
+{
+    delete_element(list, first_element(list));
+    return (SUCCESS);
+}
+
+status_t packed_pop_back(list_t *list)
+{
+    delete_element(list, last_element(list));
+    return (SUCCESS);
+}
+
+
+
+/*------------REMOVE THE ELEMENT AFTER / BEFORE / HOLDING THE GIVEN DATA------------*/
+status_t packed_pop_after(list_t *list, const void * existing_data, const type_t existing_type)
+{
+    unsigned int index = packed_find(list, existing_data, existing_type);
+    if(!index)
+        return (LIST_DATA_NOT_FOUND);
+
+    index = next_element(list, index);
+    if(!index)
+        return (FAILED);
+
+    delete_element(list, index);
+    return (SUCCESS);
+}
+
+status_t packed_pop_before(list_t *list, const void * existing_data, const type_t existing_type)
+{
+    unsigned int index = packed_find(list, existing_data, existing_type);
+    if(!index)
+        return (LIST_DATA_NOT_FOUND);
+
+    index = prev_element(list, index);
+    if(!index)
+        return (FAILED);
+
+    delete_element(list, index);
+    return (SUCCESS);
+}
+
+status_t packed_remove_data(list_t *list, const void * delete_data, const type_t delete_type)
+{
+    unsigned int index = packed_find(list, delete_data, delete_type);
+    if(!index)
+        return (LIST_DATA_NOT_FOUND);
+
+    delete_element(list, index);
+    return (SUCCESS);
+}
+
+
+
+/*------------FETCH THE FIRST / LAST ELEMENT------------*/
+status_t packed_get_front(const list_t *list, node_t **front_node)
+{
+    return fetch_element(list, first_element(list), front_node);
+}
+
+status_t packed_get_back(const list_t *list, node_t **last_node)
+{
+    return fetch_element(list, last_element(list), last_node);
+}
+
+
+
+/*------------FETCH THE ELEMENT AFTER / BEFORE AN EXISTING ELEMENT------------*/
+status_t packed_get_after(const list_t *list, const void * existing_data, const type_t existing_type,
+    node_t **target_node)
+{
+    unsigned int index = packed_find(list, existing_data, existing_type);
+    if(!index)
+        return (LIST_DATA_NOT_FOUND);
+
+    index = next_element(list, index);
+    if(!index)
+        return (FAILED);
+
+    return fetch_element(list, index, target_node);
+}
+
+status_t packed_get_before(const list_t *list, const void * existing_data, const type_t existing_type,
+    node_t **target_node)
+{
+    unsigned int index = packed_find(list, existing_data, existing_type);
+    if(!index)
+        return (LIST_DATA_NOT_FOUND);
+
+    index = prev_element(list, index);
+    if(!index)
+        return (FAILED);
+
+    return fetch_element(list, index, target_node);
+}
+
+
+
+/*------------VIEW THE FIRST / LAST ELEMENT------------*/
+status_t packed_peek_front(const list_t *list, view_t *view)
+{
+    return view_element(list, first_element(list), view);
+}
+
+status_t packed_peek_back(const list_t *list, view_t *view)
+{
+    return view_element(list, last_element(list), view);
+}
+
+
+
+/*------------VIEW THE ELEMENT AFTER / BEFORE AN EXISTING ELEMENT------------*/
+status_t packed_peek_after(const list_t *list, const void * existing_data, const type_t existing_type,
+    view_t *view)
+{
+    unsigned int index = packed_find(list, existing_data, existing_type);
+    if(!index)
+        return (LIST_DATA_NOT_FOUND);
+
+    index = next_element(list, index);
+    if(!index)
+        return (FAILED);
+
+    return view_element(list, index, view);
+}
+
+status_t packed_peek_before(const list_t *list, const void * existing_data, const type_t existing_type,
+    view_t *view)
+{
+    unsigned int index = packed_find(list, existing_data, existing_type);
+    if(!index)
+        return (LIST_DATA_NOT_FOUND);
+
+    index = prev_element(list, index);
+    if(!index)
+        return (FAILED);
+
+    return view_element(list, index, view);
+}
+
+
+
+/*------------RENDER ALL ELEMENTS, IN THE FORMAT OF show_list()------------*/
+status_t packed_render_list(const list_t *list, out_buffer_t *out, display_t display, format_t format)
+{
+    node_t element;
+    status_t status;
+
+    out_string(out, "[START] <-> ");
+    for(unsigned int index = first_element(list); index; index = next_element(list, index)) {
+        element_node(node_at(list->packed, index), &element);
+
+        status = render_data(out, &element, display, format);
+        if(!(status == SUCCESS))
+            return (status);
+
+        out_string(out, " <-> ");
+    }
+    out_string(out, "[END]\n");
+
+    return (out->status);
+}
+
+
+
+/*------------SEARCH DATA IN THE ELEMENTS------------*/
+bool_t packed_contains(const list_t *list, const void * data, const type_t type)
+{
+    return (packed_find(list, data, type) != 0);
+}
+
+
+
+/*------------MAKE ROOM FOR 'count' MORE ELEMENTS------------*/
+status_t packed_reserve(list_t *list, const len_t count)
+{
+    if(!list->packed && start_pool(list) != SUCCESS)
+        return (MEMORY_ERROR);
+
+    packed_pool_t *pool = list->packed;
+    if(count > PACKED_MAX_NODES)
+        return (MEMORY_ERROR);
+
+    while(pool->capacity - pool->used < count) {
+        if(grow_pool(pool) != SUCCESS)
+            return (MEMORY_ERROR);
+    }
+
+    return (SUCCESS);
+}
+
+
+
+/*------------APPEND ALL ELEMENTS OF 'src' TO 'dst' (src becomes empty)------------*/
+/* indices belong to one list: the elements are copied, not relinked. */
+status_t packed_concat(list_t *dst, list_t *src)
+{
+    if(packed_reserve(dst, src->length) != SUCCESS)
+        return (MEMORY_ERROR);
+
+    for(unsigned int index = first_element(src); index; index = next_element(src, index)) {
+        const packed_node_t *node = node_at(src->packed, index);
+        insert_element(dst, last_element(dst), node->value, tag_of(node));
+    }
+
+    packed_clear(src);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------DEALLOCATE ALL NODES (the pool is made again by the next insertion)------------*/
+void packed_clear(list_t *list)
+{
+    packed_pool_t *pool = list->packed;
+
+    list->stats.removals += list->length;
+    STATS_GLOBAL(removals, list->length);
+    list->length = 0;
+
+    if(!pool)
+        return;
+
+    for(unsigned int i = 0; i < pool->chunk_count; i++)
+        free(pool->chunks[i]);
+    free(pool->chunks);
+    free(pool);
+
+    list->packed = NULL;
+}
@@ -0,0 +1,664 @@
+#include "genlist.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+
+/*Persistent list: the whole list lives in one file, mapped in memory.
+The file starts with a header holding the dummy node, then nodes and payload blocks handed out from 'used' on.
+Links and payloads are offsets from the start of the file, never pointers, so the file is valid
+wherever it gets mapped: a new process maps it and uses the list at once, with nothing to rebuild.
+The file doubles when it runs out of room. Freed nodes and payload blocks are kept in free lists in the file.
+plist_sync() is the durability point. Every link update writes the new node first, then publishes it with
+one ordered 8-byte store to the 'next' link: if the process dies midway, the 'next' ring is whole and
+the file, marked dirty while it is open, gets its 'prev' links and its length rebuilt when reopened.
+A system crash may write back the dirty pages of the mapping in any order, so the changes made
+since the last plist_sync() can then leave the file unreadable (open_plist() rejects it).
+Not thread-safe, and one process at a time.*/
+
+
+
+/*------------FILE FORMAT------------*/
+#define PLIST_MAGIC         "GLPL"
+#define PLIST_VERSION       1
+#define PLIST_BYTE_ORDER    0x0102
+#define PLIST_INITIAL_SIZE  (64 * 1024)
+#define PLIST_ALIGN         16
+#define HEAD_OFFSET         ((unsigned long long) offsetof(struct Persistent_Header, head))
+
+
+
+/*------------ADDRESS OF AN OFFSET IN THE MAPPING------------*/
+static struct Persistent_Header* header_of(const plist_t *list)
+{
+    return (struct Persistent_Header*) list->base;
+}
+
+static struct Persistent_Node* node_at(const plist_t *list, const unsigned long long offset)
+{
+    return (struct Persistent_Node*) (list->base + offset);
+}
+
+
+
+/*------------MAP 'size' BYTES OF THE FILE------------*/
+static char* map_file(const int fd, const unsigned long long size)
+{
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    return (base == MAP_FAILED) ? NULL : (char*) base;
+}
+
+
+
+/*------------MAKE ROOM FOR 'bytes' MORE BYTES (the mapping may move: offsets stay valid, pointers don't)------------*/
+static status_t grow_file(plist_t *list, const unsigned long long bytes)
+{
+    struct Persistent_Header *header = header_of(list);
+    unsigned long long old_size = header->file_size, size = old_size;
+
+    while(size - header->used < bytes)
+        size *= 2;
+
+    /* map the bigger file before letting the old mapping go: on failure the list stays as it was. */
+    if(ftruncate(list->fd, (off_t)size) != 0)
+        return (MEMORY_ERROR);
+
+    char *base = map_file(list->fd, size);
+    if(!base) {
+        /* shrink back: the bytes past the recorded size would only be unused room. */
+        while(ftruncate(list->fd, (off_t)old_size) != 0 && errno == EINTR)
+            ;
+        return (MEMORY_ERROR);
+    }
+
+    munmap(list->base, list->mapped);
+    list->base = base;
+    list->mapped = size;
+    header_of(list)->file_size = size;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------HAND OUT 'bytes' FRESH BYTES OF THE FILE, 0: NO ROOM------------*/
+static unsigned long long file_alloc(plist_t *list, const unsigned long long bytes)
+{
+    struct Persistent_Header *header = header_of(list);
+
+    if(header->file_size - header->used < bytes) {
+        if(grow_file(list, bytes) != SUCCESS)
+            return (0);
+        header = header_of(list);
+    }
+
+    unsigned long long offset = header->used;
+    header->used += bytes;
+
+    return (offset);
+}
+
+
+
+/*------------NODES: FREE LIST FIRST, THEN FRESH BYTES------------*/
+static unsigned long long alloc_node(plist_t *list)
+{
+    struct Persistent_Header *header = header_of(list);
+
+    if(header->free_nodes) {
+        unsigned long long offset = header->free_nodes;
+        header->free_nodes = node_at(list, offset)->next;
+        return (offset);
+    }
+
+    return file_alloc(list, sizeof(struct Persistent_Node));
+}
+
+static void free_node(plist_t *list, const unsigned long long offset)
+{
+    struct Persistent_Header *header = header_of(list);
+
+    node_at(list, offset)->next = header->free_nodes;
+    header->free_nodes = offset;
+}
+
+
+
+/*------------PAYLOAD BLOCKS: ONE FREE LIST PER POWER OF TWO SIZE------------*/
+static unsigned int size_class(const unsigned int size)
+{
+    unsigned int class = 0;
+    while(((unsigned long long)PLIST_ALIGN << class) < size)
+        class++;
+
+    return (class);
+}
+
+static unsigned long long alloc_payload(plist_t *list, const unsigned int size)
+{
+    unsigned int class = size_class(size);
+    struct Persistent_Header *header = header_of(list);
+
+    if(header->free_payloads[class]) {
+        unsigned long long offset = header->free_payloads[class];
+        memcpy(&header->free_payloads[class], list->base + offset, sizeof(unsigned long long));
+        return (offset);
+    }
+
+    return file_alloc(list, (unsigned long long)PLIST_ALIGN << class);
+}
+
+static void free_payload(plist_t *list, const unsigned long long offset, const unsigned int size)
+{
+    unsigned int class = size_class(size);
+    struct Persistent_Header *header = header_of(list);
+
+    /* the first bytes of a free block link it to the next one. */
+    memcpy(list->base + offset, &header->free_payloads[class], sizeof(unsigned long long));
+    header->free_payloads[class] = offset;
+}
+
+
+
+/*------------REBUILD THE 'prev' LINKS AND THE LENGTH FROM THE 'next' RING (after a crash)------------*/
+static status_t repair_links(plist_t *list)
+{
+    struct Persistent_Header *header = header_of(list);
+    unsigned long long first = (sizeof(struct Persistent_Header) + PLIST_ALIGN - 1) / PLIST_ALIGN * PLIST_ALIGN;
+    unsigned long long limit = (header->used - first) / sizeof(struct Persistent_Node);
+    unsigned long long previous = HEAD_OFFSET, length = 0;
+
+    for(unsigned long long offset = header->head.next; offset != HEAD_OFFSET; offset = node_at(list, offset)->next) {
+        /* a link out of the nodes handed out, or a ring longer than them: not a list any more. */
+        if(offset < first || offset > header->used - sizeof(struct Persistent_Node) || length++ == limit)
+            return (FAILED);
+        node_at(list, offset)->prev = previous;
+        previous = offset;
+    }
+
+    header->head.prev = previous;
+    header->length = length;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------OPEN (OR CREATE) A PERSISTENT LIST FILE------------*/
+plist_t* open_plist(const char *path, const size_t structure_size, compare_t compare)
+{
+    if(!path)
+        return (NULL);
+
+    plist_t *list = (plist_t*) xmalloc(sizeof(plist_t));
+    if(!list)
+        return (NULL);
+
+    list->base = NULL;
+    list->opened = false;
+    list->compare = compare;
+    list->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if(list->fd < 0) {
+        free(list);
+        return (NULL);
+    }
+
+    struct stat info;
+    if(fstat(list->fd, &info) != 0)
+        return close_plist(list);
+
+    /* a new file: header, and an empty ring around the dummy node. */
+    if(info.st_size == 0) {
+        if(ftruncate(list->fd, PLIST_INITIAL_SIZE) != 0)
+            return close_plist(list);
+        list->base = map_file(list->fd, PLIST_INITIAL_SIZE);
+        list->mapped = PLIST_INITIAL_SIZE;
+        if(!list->base)
+            return close_plist(list);
+
+        struct Persistent_Header *header = header_of(list);
+        memcpy(header->magic, PLIST_MAGIC, sizeof(header->magic));
+        header->version = PLIST_VERSION;
+        header->byte_order = PLIST_BYTE_ORDER;
+        header->file_size = PLIST_INITIAL_SIZE;
+        header->used = (sizeof(struct Persistent_Header) + PLIST_ALIGN - 1) / PLIST_ALIGN * PLIST_ALIGN;
+        header->structure_size = structure_size ? structure_size : STRUCTURE_SIZE;
+        header->head.type = NULL_DATA;
+        header->head.next = header->head.prev = HEAD_OFFSET;
+        header->dirty = 1;
+        list->opened = true;
+
+        return (list);
+    }
+
+    /* an existing file: check it was written by this format, on this kind of machine. */
+    if((unsigned long long)info.st_size < sizeof(struct Persistent_Header))
+        return close_plist(list);
+    list->base = map_file(list->fd, (unsigned long long)info.st_size);
+    list->mapped = (unsigned long long)info.st_size;
+    if(!list->base)
+        return close_plist(list);
+
+    struct Persistent_Header *header = header_of(list);
+    if(memcmp(header->magic, PLIST_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != PLIST_VERSION || header->byte_order != PLIST_BYTE_ORDER ||
+        header->file_size > (unsigned long long)info.st_size || header->used > header->file_size ||
+        (structure_size && structure_size != header->structure_size))
+        return close_plist(list);
+
+    /* a crash in grow_file(), between ftruncate() and the header update, leaves the file bigger
+    than recorded: the bytes past 'used' are unused anyway, so the list takes them as room. */
+    header->file_size = (unsigned long long)info.st_size;
+
+    /* not closed by close_plist(): rebuild what a crash may have left half done. */
+    if(header->dirty && repair_links(list) != SUCCESS)
+        return close_plist(list);
+
+    header->dirty = 1;
+    list->opened = true;
+
+    return (list);
+}
+
+
+
+/*------------BUILD A NODE VIEW OF A PERSISTENT NODE (valid until the next insertion)------------*/
+static void view_node(const plist_t *list, const struct Persistent_Node *node, node_t *out)
+{
+    out->double_value = 0;
+    out->type = (type_t) node->type;
+    out->type_id = 0;
+    out->next = out->prev = NULL;
+
+    if(node->size) {
+        out->data = list->base + node->data;
+        out->storage = STORE_REFERENCE;
+    } else {
+        out->double_value = node->double_value;
+        out->storage = STORE_INLINE;
+    }
+}
+
+
+
+/*------------INSERT A COPY OF THE DATA AFTER THE NODE AT 'start' (0: after the last node)------------*/
+static status_t plist_insert(plist_t *list, const unsigned long long start_offset, const void *data, const type_t type)
+{
+    unsigned int size = 0;
+
+    switch(type) {
+        case INTEGER:
+        case DOUBLE:
+        case CHARACTER:
+            break;
+        case STRING:
+            size = (unsigned int) strlen((const char*)data) + 1;
+            break;
+        case STRUCTURE:
+            size = header_of(list)->structure_size;
+            if(!size)
+                return (INVALID_TYPE);
+            break;
+        default:
+            return (INVALID_TYPE);
+    }
+
+    /* allocate first: the file may grow and move. */
+    unsigned long long payload = 0;
+    if(size) {
+        payload = alloc_payload(list, size);
+        if(!payload)
+            return (MEMORY_ERROR);
+    }
+
+    unsigned long long offset = alloc_node(list);
+    if(!offset) {
+        if(payload)
+            free_payload(list, payload, size);
+        return (MEMORY_ERROR);
+    }
+
+    struct Persistent_Header *header = header_of(list);
+    struct Persistent_Node *newNode = node_at(list, offset);
+
+    newNode->data = 0;
+    newNode->type = type;
+    newNode->size = size;
+    switch(type) {
+        case INTEGER:
+            newNode->int_value = *(const int*)data;
+            break;
+        case DOUBLE:
+            newNode->double_value = *(const double*)data;
+            break;
+        case CHARACTER:
+            newNode->char_value = *(const char*)data;
+            break;
+        default:
+            memcpy(list->base + payload, data, size);
+            newNode->data = payload;
+            break;
+    }
+
+    /* link it between 'start' and 'end', all by offsets. the node is complete before the
+    store which publishes it: a crash leaves it either out of the 'next' ring or fully in it. */
+    unsigned long long start = start_offset ? start_offset : header->head.prev;
+    unsigned long long end = node_at(list, start)->next;
+
+    newNode->prev = start;
+    newNode->next = end;
+    __atomic_store_n(&node_at(list, start)->next, offset, __ATOMIC_RELEASE);
+    node_at(list, end)->prev = offset;
+    header->length++;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------INSERT NODE AT FRONT / BACK (the data is copied into the file)------------*/
+status_t plist_put_front(plist_t *list, const void *data, const type_t type)
+{
+    if(!list || !data)
+        return (INVALID_DATA);
+
+    return plist_insert(list, HEAD_OFFSET, data, type);
+}
+
+status_t plist_put_back(plist_t *list, const void *data, const type_t type)
+{
+    if(!list || !data)
+        return (INVALID_DATA);
+
+    return plist_insert(list, 0, data, type);
+}
+
+status_t plist_put_back_int(plist_t *list, const int value)
+{
+    if(!list)
+        return (INVALID_DATA);
+
+    return plist_insert(list, 0, &value, INTEGER);
+}
+
+
+
+/*------------UNLINK A NODE AND FREE IT WITH ITS PAYLOAD------------*/
+static void plist_delete(plist_t *list, const unsigned long long offset)
+{
+    struct Persistent_Node *node = node_at(list, offset);
+
+    /* out of the 'next' ring in one store, before anything else changes. */
+    __atomic_store_n(&node_at(list, node->prev)->next, node->next, __ATOMIC_RELEASE);
+    node_at(list, node->next)->prev = node->prev;
+
+    if(node->size)
+        free_payload(list, node->data, node->size);
+    free_node(list, offset);
+    header_of(list)->length--;
+}
+
+
+
+/*------------DELETE NODE AT FRONT / BACK------------*/
+status_t plist_pop_front(plist_t *list)
+{
+    if(!list)
+        return (INVALID_DATA);
+    if(!header_of(list)->length)
+        return (LIST_EMPTY);
+
+    plist_delete(list, header_of(list)->head.next);
+    return (SUCCESS);
+}
+
+status_t plist_pop_back(plist_t *list)
+{
+    if(!list)
+        return (INVALID_DATA);
+    if(!header_of(list)->length)
+        return (LIST_EMPTY);
+
+    plist_delete(list, header_of(list)->head.prev);
+    return (SUCCESS);
+}
+
+
+
+/*------------GET THE FRONT / BACK NODE (a view into the file, valid until the next insertion)------------*/
+status_t plist_get_front(const plist_t *list, node_t *out)
+{
+    if(!list || !out)
+        return (INVALID_DATA);
+    if(!header_of(list)->length)
+        return (LIST_EMPTY);
+
+    view_node(list, node_at(list, header_of(list)->head.next), out);
+    return (SUCCESS);
+}
+
+status_t plist_get_back(const plist_t *list, node_t *out)
+{
+    if(!list || !out)
+        return (INVALID_DATA);
+    if(!header_of(list)->length)
+        return (LIST_EMPTY);
+
+    view_node(list, node_at(list, header_of(list)->head.prev), out);
+    return (SUCCESS);
+}
+
+
+
+/*------------SEARCH THE DATA, 0: NOT FOUND------------*/
+static unsigned long long plist_search(const plist_t *list, const void *data, const type_t type)
+{
+    const struct Persistent_Header *header = header_of(list);
+    node_t view;
+
+    for(unsigned long long offset = header->head.next; offset != HEAD_OFFSET; offset = node_at(list, offset)->next) {
+        const struct Persistent_Node *node = node_at(list, offset);
+        if(node->type != (unsigned int)type)
+            continue;
+
+        if(type != STRUCTURE) {
+            view_node(list, node, &view);
+            if(match_data(NULL, &view, data, type))
+                return (offset);
+        } else if(list->compare) {
+            if(list->compare(list->base + node->data, data) == 0)
+                return (offset);
+        } else if(memcmp(list->base + node->data, data, node->size) == 0) {
+            return (offset);
+        }
+    }
+
+    return (0);
+}
+
+status_t plist_contains(const plist_t *list, const void *data, const type_t type)
+{
+    if(!list || !data)
+        return (INVALID_DATA);
+
+    return plist_search(list, data, type) ? TRUE : FALSE;
+}
+
+
+
+/*------------DELETE THE FIRST NODE HOLDING THE DATA------------*/
+status_t plist_remove_data(plist_t *list, const void *data, const type_t type)
+{
+    if(!list || !data)
+        return (INVALID_DATA);
+
+    unsigned long long offset = plist_search(list, data, type);
+    if(!offset)
+        return (LIST_DATA_NOT_FOUND);
+
+    plist_delete(list, offset);
+    return (SUCCESS);
+}
+
+
+
+/*------------INSERT NODE AFTER / BEFORE AN EXISTING NODE------------*/
+status_t plist_put_after(plist_t *list, const void *existing_data, const type_t existing_type,
+    const void *new_data, const type_t new_type)
+{
+    if(!list || !existing_data || !new_data)
+        return (INVALID_DATA);
+    if(!header_of(list)->length)
+        return (LIST_EMPTY);
+
+    /* an offset, not a pointer: it stays valid when the insertion grows the file. */
+    unsigned long long offset = plist_search(list, existing_data, existing_type);
+    if(!offset)
+        return (LIST_DATA_NOT_FOUND);
+
+    return plist_insert(list, offset, new_data, new_type);
+}
+
+status_t plist_put_before(plist_t *list, const void *existing_data, const type_t existing_type,
+    const void *new_data, const type_t new_type)
+{
+    if(!list || !existing_data || !new_data)
+        return (INVALID_DATA);
+    if(!header_of(list)->length)
+        return (LIST_EMPTY);
+
+    unsigned long long offset = plist_search(list, existing_data, existing_type);
+    if(!offset)
+        return (LIST_DATA_NOT_FOUND);
+
+    return plist_insert(list, node_at(list, offset)->prev, new_data, new_type);
+}
+
+
+
+/*------------DELETE NODE AFTER / BEFORE AN EXISTING NODE------------*/
+status_t plist_pop_after(plist_t *list, const void *existing_data, const type_t existing_type)
+{
+    if(!list || !existing_data)
+        return (INVALID_DATA);
+    if(!header_of(list)->length)
+        return (LIST_EMPTY);
+
+    unsigned long long offset = plist_search(list, existing_data, existing_type);
+    if(!offset)
+        return (LIST_DATA_NOT_FOUND);
+
+    /* the last node has nothing after it. */
+    unsigned long long next = node_at(list, offset)->next;
+    if(next == HEAD_OFFSET)
+        return (FAILED);
+
+    plist_delete(list, next);
+    return (SUCCESS);
+}
+
+status_t plist_pop_before(plist_t *list, const void *existing_data, const type_t existing_type)
+{
+    if(!list || !existing_data)
+        return (INVALID_DATA);
+    if(!header_of(list)->length)
+        return (LIST_EMPTY);
+
+    unsigned long long offset = plist_search(list, existing_data, existing_type);
+    if(!offset)
+        return (LIST_DATA_NOT_FOUND);
+
+    unsigned long long prev = node_at(list, offset)->prev;
+    if(prev == HEAD_OFFSET)
+        return (FAILED);
+
+    plist_delete(list, prev);
+    return (SUCCESS);
+}
+
+
+
+/*------------NUMBER OF DATA NODES------------*/
+len_t plist_length(const plist_t *list)
+{
+    if(!list)
+        return (0);
+
+    return (len_t) header_of(list)->length;
+}
+
+
+
+/*------------DISPLAY THE PERSISTENT LIST------------*/
+status_t show_plist(const plist_t *list, display_t display)
+{
+    if(!list || !header_of(list)->length)
+        return (LIST_EMPTY);
+
+    fflush(stdout);
+
+    out_buffer_t out;
+    if(out_open(&out, fileno(stdout)) != SUCCESS)
+        return (MEMORY_ERROR);
+
+    status_t status = SUCCESS;
+    node_t view;
+
+    out_string(&out, "[START] <-> ");
+    for(unsigned long long offset = header_of(list)->head.next; offset != HEAD_OFFSET; offset = node_at(list, offset)->next) {
+        view_node(list, node_at(list, offset), &view);
+        status = render_data(&out, &view, display, NULL);
+        if(!(status == SUCCESS))
+            break;
+        out_string(&out, " <-> ");
+    }
+    if(status == SUCCESS)
+        out_string(&out, "[END]\n");
+
+    status_t closed = out_close(&out);
+
+    return (status == SUCCESS) ? closed : status;
+}
+
+
+
+/*------------DURABILITY POINT: WRITE EVERY CHANGE BACK TO THE FILE------------*/
+status_t plist_sync(plist_t *list)
+{
+    if(!list || !list->base)
+        return (INVALID_DATA);
+
+    return (msync(list->base, list->mapped, MS_SYNC) == 0) ? SUCCESS : FAILED;
+}
+
+
+
+/*------------SYNC, UNMAP AND CLOSE THE FILE------------*/
+plist_t* close_plist(plist_t *list)
+{
+    if(!list)
+        return (NULL);
+
+    if(list->base) {
+        /* a file which failed the checks of open_plist() is left as it was. */
+        if(list->opened) {
+            plist_sync(list);
+            header_of(list)->dirty = 0;
+            plist_sync(list);
+        }
+        munmap(list->base, list->mapped);
+    }
+    if(list->fd >= 0)
+        close(list->fd);
+    free(list);
+
+    return (NULL);
+}
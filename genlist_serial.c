@@ -0,0 +1,385 @@
+#include "genlist.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+
+
+
+/*Binary list file, version 1 (host byte order, checked on load):
+    header          struct File_Header, then 'type_count' registered type sizes (unsigned int).
+    type stream     one byte per element: its data type.
+    type id stream  one unsigned short per STRUCTURE element: its registered type id.
+    value stream    per element: INTEGER 4 bytes, DOUBLE 8, CHARACTER 1,
+                    STRING unsigned int length + bytes, STRUCTURE the bytes of its size.
+All values are loaded inline or into one payload block, held by the list pool.*/
+
+
+
+/*------------FILE FORMAT------------*/
+#define FILE_MAGIC          "GLST"
+#define FILE_VERSION        1
+#define FILE_BYTE_ORDER     0x0102
+#define IN_BUFFER_SIZE      (1 << 20)
+#define PAYLOAD_ALIGN       16          // STRUCTURE data is aligned for any member type.
+
+struct File_Header {
+    char magic[4];
+    unsigned short version;
+    unsigned short byte_order;
+    unsigned long long count;                   // elements.
+    unsigned long long structure_count;         // STRUCTURE elements: entries of the type id stream.
+    unsigned long long payload_size;            // STRING (with '\0') and STRUCTURE bytes.
+    unsigned int structure_size;                // size of unregistered STRUCTURE data.
+    unsigned int type_count;                    // registered types.
+};
+
+
+
+/*------------INPUT BUFFER (big sequential reads)------------*/
+struct In_Buffer {
+    int fd;
+    char *data;
+    long unsigned int position;
+    long unsigned int length;
+};
+
+static status_t in_read(struct In_Buffer *in, void *target, len_t size)
+{
+    char *bytes = (char*) target;
+
+    while(size > 0) {
+        if(in->position == in->length) {
+            /* blocks bigger than the buffer are read straight into place. */
+            char *into = (size >= IN_BUFFER_SIZE) ? bytes : in->data;
+            len_t wanted = (size >= IN_BUFFER_SIZE) ? size : IN_BUFFER_SIZE;
+
+            ssize_t got = read(in->fd, into, wanted);
+            if(got < 0 && errno == EINTR)
+                continue;
+            if(got <= 0)
+                return (INVALID_DATA);     // error, or the file ends too early.
+
+            if(into == bytes) {
+                bytes += got;
+                size -= (len_t)got;
+                continue;
+            }
+            in->position = 0;
+            in->length = (len_t)got;
+        }
+
+        len_t part = in->length - in->position;
+        if(part > size)
+            part = size;
+        memcpy(bytes, in->data + in->position, part);
+        in->position += part;
+        bytes += part;
+        size -= part;
+    }
+
+    return (SUCCESS);
+}
+
+
+
+/*------------SIZE OF THE STRUCTURE DATA OF ONE NODE------------*/
+static len_t structure_bytes(const list_t *list, const node_t *node)
+{
+    const structure_type_t *info = structure_type(list, node_type(node));
+    if(info)
+        return (info->size);
+
+    return (list->structure_size ? list->structure_size : STRUCTURE_SIZE);
+}
+
+
+
+/*------------WRITE THE LIST TO A FILE DESCRIPTOR------------*/
+status_t list_save(const list_t *list, const int fd)
+{
+    if(!list || fd < 0)
+        return (INVALID_DATA);
+
+    if(list->backend != LINKED_LIST)
+        return (LIST_UNSUPPORTED);
+
+    struct File_Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+    header.version = FILE_VERSION;
+    header.byte_order = FILE_BYTE_ORDER;
+    header.count = list->length;
+    header.structure_size = list->structure_size ? list->structure_size : STRUCTURE_SIZE;
+    header.type_count = list->type_count;
+
+    /* first pass: sizes of the type id stream and of the payloads. */
+    for(node_t *current = list->head.next; current != &list->head; current = current->next) {
+        switch(current->type) {
+            case INTEGER:
+            case DOUBLE:
+            case CHARACTER:
+                break;
+            case STRING:
+                header.payload_size += strlen((const char*)current->data) + 1;
+                break;
+            case STRUCTURE:
+                header.structure_count++;
+                header.payload_size += structure_bytes(list, current);
+                break;
+            default:
+                return (INVALID_TYPE);
+        }
+    }
+
+    out_buffer_t out;
+    if(out_open(&out, fd) != SUCCESS)
+        return (MEMORY_ERROR);
+
+    out_bytes(&out, (const char*)&header, sizeof(header));
+    for(unsigned int i = 0; i < list->type_count; i++)
+        out_bytes(&out, (const char*)&list->types[i].size, sizeof(unsigned int));
+
+    node_t *current;
+
+    for(current = list->head.next; current != &list->head; current = current->next)
+        out_char(&out, (char)current->type);
+
+    for(current = list->head.next; current != &list->head; current = current->next)
+        if(current->type == STRUCTURE)
+            out_bytes(&out, (const char*)&current->type_id, sizeof(unsigned short));
+
+    for(current = list->head.next; current != &list->head; current = current->next) {
+        const char *data = (const char*) node_data(current);
+
+        switch(current->type) {
+            case INTEGER:
+                out_bytes(&out, data, sizeof(int));
+                break;
+            case DOUBLE:
+                out_bytes(&out, data, sizeof(double));
+                break;
+            case CHARACTER:
+                out_bytes(&out, data, sizeof(char));
+                break;
+            case STRING: {
+                unsigned int length = (unsigned int) strlen(data);
+                out_bytes(&out, (const char*)&length, sizeof(length));
+                out_bytes(&out, data, length);
+                break;
+            }
+            default:
+                out_bytes(&out, data, structure_bytes(list, current));
+                break;
+        }
+    }
+
+    return out_close(&out);
+}
+
+
+
+/*------------READ ONE VALUE INTO A NODE (STRING / STRUCTURE bytes go to the payload block)------------*/
+static status_t load_value(struct In_Buffer *in, const list_t *list, node_t *node,
+    char **payload, const char *payload_end)
+{
+    len_t size;
+
+    node->double_value = 0;
+    node->storage = STORE_INLINE;
+    node->hash_tag = 0;
+
+    switch(node->type) {
+        case INTEGER:
+            return in_read(in, &node->int_value, sizeof(int));
+        case DOUBLE:
+            return in_read(in, &node->double_value, sizeof(double));
+        case CHARACTER:
+            return in_read(in, &node->char_value, sizeof(char));
+        case STRING: {
+            unsigned int length;
+            if(in_read(in, &length, sizeof(length)) != SUCCESS)
+                return (INVALID_DATA);
+            size = (len_t)length + 1;
+            break;
+        }
+        default:
+            size = structure_bytes(list, node);
+            break;
+    }
+
+    if(node->type == STRUCTURE)
+        *payload += (PAYLOAD_ALIGN - ((long unsigned int)*payload % PAYLOAD_ALIGN)) % PAYLOAD_ALIGN;
+
+    /* the header told the payload size: never go past it. */
+    if(*payload > payload_end || size > (len_t)(payload_end - *payload))
+        return (INVALID_DATA);
+
+    len_t stored = (node->type == STRING) ? size - 1 : size;
+    if(in_read(in, *payload, stored) != SUCCESS)
+        return (INVALID_DATA);
+    if(node->type == STRING)
+        (*payload)[stored] = '\0';
+
+    node->data = *payload;
+    node->storage = STORE_REFERENCE;
+    tag_node(node);
+    *payload += size;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------CHECK THE HEADER AGAINST THIS BUILD AND THE TARGET LIST------------*/
+static status_t check_header(struct In_Buffer *in, const list_t *list, struct File_Header *header)
+{
+    if(in_read(in, header, sizeof(*header)) != SUCCESS)
+        return (INVALID_DATA);
+
+    if(memcmp(header->magic, FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != FILE_VERSION || header->byte_order != FILE_BYTE_ORDER ||
+        header->structure_count > header->count)
+        return (INVALID_DATA);
+
+    /* registered types are matched by id: the list must register the same sizes first. */
+    if(header->type_count > list->type_count)
+        return (INVALID_TYPE);
+
+    for(unsigned int i = 0; i < header->type_count; i++) {
+        unsigned int size;
+        if(in_read(in, &size, sizeof(size)) != SUCCESS)
+            return (INVALID_DATA);
+        if(size != list->types[i].size)
+            return (INVALID_TYPE);
+    }
+
+    return (SUCCESS);
+}
+
+
+
+/*------------APPEND THE ELEMENTS OF A LIST FILE TO THE LIST------------*/
+status_t list_load(list_t *list, const int fd)
+{
+    if(!list || fd < 0)
+        return (INVALID_DATA);
+
+    if(list->backend != LINKED_LIST)
+        return (LIST_UNSUPPORTED);
+
+    struct In_Buffer in = { fd, NULL, 0, 0 };
+    struct File_Header header;
+    unsigned char *types = NULL;
+    unsigned short *type_ids = NULL;
+    node_t *first = NULL, *last = NULL;
+    len_t loaded = 0;
+    status_t status;
+
+    in.data = (char*) xmalloc(IN_BUFFER_SIZE);
+    if(!in.data)
+        return (MEMORY_ERROR);
+
+    status = check_header(&in, list, &header);
+    if(status != SUCCESS)
+        goto done;
+
+    if(header.structure_count && header.structure_size != (list->structure_size ? list->structure_size : STRUCTURE_SIZE)) {
+        status = INVALID_TYPE;
+        goto done;
+    }
+
+    /* the type streams, read whole. */
+    types = (unsigned char*) xmalloc(header.count ? header.count : 1);
+    type_ids = (unsigned short*) xmalloc(header.structure_count ? header.structure_count * sizeof(unsigned short) : 1);
+    if(!types || !type_ids) {
+        status = MEMORY_ERROR;
+        goto done;
+    }
+    if(in_read(&in, types, header.count) != SUCCESS ||
+        in_read(&in, type_ids, header.structure_count * sizeof(unsigned short)) != SUCCESS) {
+        status = INVALID_DATA;
+        goto done;
+    }
+
+    /* one payload block (with room to align each structure) and one slab for everything. */
+    pool_t *pool = list_pool(list);
+    len_t payload_size = header.payload_size + header.structure_count * (PAYLOAD_ALIGN - 1);
+    char *payload = NULL;
+    if(payload_size) {
+        payload = (char*) pool_payload(pool, payload_size);
+        if(!payload) {
+            status = MEMORY_ERROR;
+            goto done;
+        }
+    }
+    const char *payload_end = payload + payload_size;
+
+    if(pool_reserve(pool, header.count) != SUCCESS) {
+        status = MEMORY_ERROR;
+        goto done;
+    }
+
+    len_t structure_index = 0;
+    for(len_t i = 0; i < header.count; i++) {
+        node_t *newNode = pool_alloc(pool);
+
+        newNode->type = (type_t)types[i];
+        newNode->type_id = 0;
+        newNode->prev = last;
+        newNode->next = NULL;
+        if(last)
+            last->next = newNode;
+        else
+            first = newNode;
+        last = newNode;
+        loaded++;
+
+        switch(newNode->type) {
+            case INTEGER:
+            case DOUBLE:
+            case CHARACTER:
+            case STRING:
+                break;
+            case STRUCTURE:
+                if(structure_index == header.structure_count) {
+                    status = INVALID_DATA;
+                    goto done;
+                }
+                newNode->type_id = type_ids[structure_index++];
+                if(newNode->type_id > header.type_count) {
+                    status = INVALID_TYPE;
+                    goto done;
+                }
+                break;
+            default:
+                status = INVALID_TYPE;
+                goto done;
+        }
+
+        status = load_value(&in, list, newNode, &payload, payload_end);
+        if(status != SUCCESS)
+            goto done;
+    }
+
+    /* link the whole chain at once. */
+    STATS_COUNT(list, allocations, loaded);
+    if(loaded)
+        generic_insert_chain(list, list->head.prev, first, last, &list->head, loaded);
+    first = NULL;
+    status = SUCCESS;
+
+done:
+    /* on error, nodes read so far go back to the pool (the payload block stays with it). */
+    while(first) {
+        node_t *next = first->next;
+        pool_free(list_pool(list), first);
+        first = next;
+    }
+    free(types);
+    free(type_ids);
+    free(in.data);
+
+    return (status);
+}
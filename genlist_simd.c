@@ -0,0 +1,203 @@
+#include "genlist.h"
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GENLIST_X86 1
+#include <immintrin.h>
+#endif
+
+
+
+/*------------KERNEL IN USE (picked on the first search)------------*/
+static kernel_t active_kernel = KERNEL_AUTO;
+
+
+
+/*------------ONLY THE BITS OF THE ELEMENTS IN USE------------*/
+static unsigned int count_mask(const block_t *block)
+{
+    return (block->count < UNROLLED_BLOCK_SIZE) ? (1u << block->count) - 1 : ~0u;
+}
+
+
+
+/*------------SCALAR KERNELS: ONE BIT PER ELEMENT WITH THIS TAG / THESE 8 VALUE BYTES------------*/
+static unsigned int tags_scalar(const block_t *block, const unsigned char tag)
+{
+    unsigned int mask = 0;
+
+    for(unsigned int i = 0; i < block->count; i++)
+        mask |= (unsigned int)(block->tags[i] == tag) << i;
+
+    return (mask);
+}
+
+static unsigned int values_scalar(const block_t *block, const value_t key)
+{
+    unsigned long long wanted, value;
+    unsigned int mask = 0;
+
+    memcpy(&wanted, &key, sizeof(wanted));
+    for(unsigned int i = 0; i < block->count; i++) {
+        memcpy(&value, &block->values[i], sizeof(value));
+        mask |= (unsigned int)(value == wanted) << i;
+    }
+
+    return (mask);
+}
+
+
+
+#ifdef GENLIST_X86
+/*------------SSE2 KERNELS: 16 TAGS / 2 VALUES PER COMPARE------------*/
+__attribute__((target("sse2")))
+static unsigned int tags_sse2(const block_t *block, const unsigned char tag)
+{
+    const __m128i wanted = _mm_set1_epi8((char)tag);
+    unsigned int mask = 0;
+
+    for(unsigned int i = 0; i < UNROLLED_BLOCK_SIZE; i += 16) {
+        __m128i tags = _mm_loadu_si128((const __m128i*)&block->tags[i]);
+        mask |= (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(tags, wanted)) << i;
+    }
+
+    return (mask & count_mask(block));
+}
+
+__attribute__((target("sse2")))
+static unsigned int values_sse2(const block_t *block, const value_t key)
+{
+    long long bits;
+    memcpy(&bits, &key, sizeof(bits));
+
+    const __m128i wanted = _mm_set1_epi64x(bits);
+    unsigned int mask = 0;
+
+    /* SSE2 has no 64-bit compare: both 32-bit halves must be equal. */
+    for(unsigned int i = 0; i < UNROLLED_BLOCK_SIZE; i += 2) {
+        __m128i values = _mm_loadu_si128((const __m128i*)&block->values[i]);
+        __m128i equal = _mm_cmpeq_epi32(values, wanted);
+        equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+        mask |= (unsigned int)_mm_movemask_pd(_mm_castsi128_pd(equal)) << i;
+    }
+
+    return (mask & count_mask(block));
+}
+
+
+
+/*------------AVX2 KERNELS: 32 TAGS / 4 VALUES PER COMPARE------------*/
+__attribute__((target("avx2")))
+static unsigned int tags_avx2(const block_t *block, const unsigned char tag)
+{
+    __m256i tags = _mm256_loadu_si256((const __m256i*)block->tags);
+    unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(tags, _mm256_set1_epi8((char)tag)));
+
+    return (mask & count_mask(block));
+}
+
+__attribute__((target("avx2")))
+static unsigned int values_avx2(const block_t *block, const value_t key)
+{
+    long long bits;
+    memcpy(&bits, &key, sizeof(bits));
+
+    const __m256i wanted = _mm256_set1_epi64x(bits);
+    unsigned int mask = 0;
+
+    for(unsigned int i = 0; i < UNROLLED_BLOCK_SIZE; i += 4) {
+        __m256i values = _mm256_loadu_si256((const __m256i*)&block->values[i]);
+        __m256i equal = _mm256_cmpeq_epi64(values, wanted);
+        mask |= (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(equal)) << i;
+    }
+
+    return (mask & count_mask(block));
+}
+#endif
+
+
+
+/*------------CAN THIS CPU RUN THE GIVEN KERNEL ?------------*/
+static bool_t kernel_available(const kernel_t kernel)
+{
+    switch(kernel) {
+        case KERNEL_SCALAR:
+            return (true);
+#ifdef GENLIST_X86
+        case KERNEL_SSE2:
+            return (__builtin_cpu_supports("sse2") != 0);
+        case KERNEL_AVX2:
+            return (__builtin_cpu_supports("avx2") != 0);
+#endif
+        default:
+            return (false);
+    }
+}
+
+
+
+/*------------CHOOSE THE SEARCH KERNEL (KERNEL_AUTO: best one of this CPU)------------*/
+status_t select_search_kernel(const kernel_t kernel)
+{
+    if(kernel == KERNEL_AUTO) {
+        if(kernel_available(KERNEL_AVX2))
+            active_kernel = KERNEL_AVX2;
+        else if(kernel_available(KERNEL_SSE2))
+            active_kernel = KERNEL_SSE2;
+        else
+            active_kernel = KERNEL_SCALAR;
+
+        return (SUCCESS);
+    }
+
+    if(!kernel_available(kernel))
+        return (LIST_UNSUPPORTED);
+
+    active_kernel = kernel;
+    return (SUCCESS);
+}
+
+
+
+/*------------KERNEL IN USE------------*/
+kernel_t search_kernel(void)
+{
+    if(active_kernel == KERNEL_AUTO)
+        select_search_kernel(KERNEL_AUTO);
+
+    return (active_kernel);
+}
+
+
+
+/*------------ONE BIT PER ELEMENT OF THE BLOCK HOLDING THIS TAG------------*/
+unsigned int match_tags(const block_t *block, const unsigned char tag)
+{
+    switch(search_kernel()) {
+#ifdef GENLIST_X86
+        case KERNEL_AVX2:
+            return tags_avx2(block, tag);
+        case KERNEL_SSE2:
+            return tags_sse2(block, tag);
+#endif
+        default:
+            return tags_scalar(block, tag);
+    }
+}
+
+
+
+/*------------ONE BIT PER ELEMENT OF THE BLOCK HOLDING THESE 8 VALUE BYTES------------*/
+unsigned int match_values(const block_t *block, const value_t key)
+{
+    switch(search_kernel()) {
+#ifdef GENLIST_X86
+        case KERNEL_AVX2:
+            return values_avx2(block, key);
+        case KERNEL_SSE2:
+            return values_sse2(block, key);
+#endif
+        default:
+            return values_scalar(block, key);
+    }
+}
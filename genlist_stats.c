@@ -0,0 +1,241 @@
+#include "genlist.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+
+
+/*Statistics: every list counts its inserts, removals and peak length.
+Built with -DGENLIST_STATS, lists also count node allocations and frees, searches, visited nodes and comparisons,
+and the same counters are summed over all lists, with xmalloc() calls and failures.
+The sums are kept per thread and added up when they are read, so counting never takes a lock.
+A thread's block is folded into the retired sums and freed when the thread exits.
+Built with -DGENLIST_LATENCY, the public functions fill one latency histogram each.
+Without these flags the counting macros expand to nothing.*/
+
+
+
+/*------------SUMS OVER ALL LISTS: ONE BLOCK PER THREAD, FREED WHEN IT EXITS------------*/
+struct Thread_Stats {
+    stats_t stats;
+    struct Thread_Stats *next;
+};
+
+__thread stats_t *genlist_thread_stats;
+latency_t genlist_latency[STAT_FUNCTIONS];
+
+static struct Thread_Stats *thread_blocks;              // blocks of the running threads.
+static stats_t shared_stats;                            // used when a block can't be allocated.
+static stats_t retired_stats;                           // sums of the threads which exited.
+static pthread_mutex_t blocks_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t block_key;                         // its destructor retires the block of the thread.
+static pthread_once_t block_key_once = PTHREAD_ONCE_INIT;
+
+#define STATS_COUNTERS  (sizeof(stats_t) / sizeof(long unsigned int))
+
+
+
+/*------------THE THREAD EXITS: FOLD ITS SUMS INTO THE RETIRED ONES AND FREE ITS BLOCK------------*/
+static void stats_retire(void *data)
+{
+    struct Thread_Stats *block = (struct Thread_Stats*) data;
+    const long unsigned int *counters = (const long unsigned int*) &block->stats;
+    long unsigned int *retired = (long unsigned int*) &retired_stats;
+
+    pthread_mutex_lock(&blocks_lock);
+    for(len_t i = 0; i < STATS_COUNTERS; i++)
+        retired[i] += counters[i];
+
+    struct Thread_Stats **link = &thread_blocks;
+    while(*link != block)
+        link = &(*link)->next;
+    *link = block->next;
+    pthread_mutex_unlock(&blocks_lock);
+
+    /* a later destructor of the thread may still count: it registers a new block. */
+    genlist_thread_stats = NULL;
+    free(block);
+}
+
+static void create_block_key(void)
+{
+    pthread_key_create(&block_key, stats_retire);
+}
+
+
+
+/*------------GIVE THE CALLING THREAD ITS OWN BLOCK OF SUMS------------*/
+void stats_register(void)
+{
+    pthread_once(&block_key_once, create_block_key);
+
+    /* not xmalloc(): it counts itself, through this block. */
+    struct Thread_Stats *block = (struct Thread_Stats*) calloc(1, sizeof(struct Thread_Stats));
+    if(!block || pthread_setspecific(block_key, block) != 0) {
+        free(block);
+        genlist_thread_stats = &shared_stats;
+        return;
+    }
+
+    /* once per thread: a lock is cheap here, and lets the destructor unlink the block. */
+    pthread_mutex_lock(&blocks_lock);
+    block->next = thread_blocks;
+    thread_blocks = block;
+    pthread_mutex_unlock(&blocks_lock);
+
+    genlist_thread_stats = &block->stats;
+}
+
+
+
+/*------------ADD UP THE SUMS OF EVERY THREAD (blocks lock held)------------*/
+static void sum_threads(long unsigned int *sums)
+{
+    const long unsigned int *shared = (const long unsigned int*) &shared_stats;
+    const long unsigned int *retired = (const long unsigned int*) &retired_stats;
+    for(len_t i = 0; i < STATS_COUNTERS; i++)
+        sums[i] = __atomic_load_n(&shared[i], __ATOMIC_RELAXED) + retired[i];
+
+    for(struct Thread_Stats *block = thread_blocks; block; block = block->next) {
+        const long unsigned int *counters = (const long unsigned int*) &block->stats;
+        for(len_t i = 0; i < STATS_COUNTERS; i++)
+            sums[i] += __atomic_load_n(&counters[i], __ATOMIC_RELAXED);
+    }
+}
+
+
+
+/*------------NAMES OF THE TIMED FUNCTIONS------------*/
+static const char *function_names[STAT_FUNCTIONS] = {
+    "put_front", "put_back", "put_after", "put_before", "put_value", "put_bulk",
+    "pop_front", "pop_back", "pop_after", "pop_before", "remove_data",
+    "get", "peek", "contains_data", "sort_list", "clear_list"
+};
+
+const char* stats_function_name(const stats_function_t function)
+{
+    if(function < 0 || function >= STAT_FUNCTIONS)
+        return (NULL);
+
+    return (function_names[function]);
+}
+
+
+
+/*------------COPY THE COUNTERS OF THE LIST (NULL: THE SUMS OVER ALL LISTS)------------*/
+status_t list_stats_get(const list_t *list, stats_t *stats)
+{
+    if(!stats)
+        return (INVALID_DATA);
+
+    if(list) {
+        *stats = list->stats;
+        return (SUCCESS);
+    }
+
+    pthread_mutex_lock(&blocks_lock);
+    sum_threads((long unsigned int*) stats);
+    pthread_mutex_unlock(&blocks_lock);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------CLEAR A BLOCK OF SUMS WHICH ITS THREAD MAY BE WRITING------------*/
+static void clear_counters(stats_t *stats)
+{
+    long unsigned int *counters = (long unsigned int*) stats;
+    for(len_t i = 0; i < STATS_COUNTERS; i++)
+        __atomic_store_n(&counters[i], 0, __ATOMIC_RELAXED);
+}
+
+
+
+/*------------CLEAR THE COUNTERS OF THE LIST (NULL: THE SUMS AND THE LATENCY HISTOGRAMS)------------*/
+status_t list_stats_reset(list_t *list)
+{
+    if(list) {
+        memset(&list->stats, 0, sizeof(stats_t));
+        /* the peak starts again from the current length. */
+        list->stats.peak_length = list->length;
+        return (SUCCESS);
+    }
+
+    /* the blocks of the other threads are cleared too: a count they are adding at this very
+    moment may write back its old total, so only sums read while no thread counts are exact. */
+    pthread_mutex_lock(&blocks_lock);
+    memset(&retired_stats, 0, sizeof(stats_t));
+    clear_counters(&shared_stats);
+    for(struct Thread_Stats *block = thread_blocks; block; block = block->next)
+        clear_counters(&block->stats);
+    pthread_mutex_unlock(&blocks_lock);
+
+    long unsigned int *counters = (long unsigned int*) genlist_latency;
+    for(len_t i = 0; i < STAT_FUNCTIONS * (sizeof(latency_t) / sizeof(long unsigned int)); i++)
+        __atomic_store_n(&counters[i], 0, __ATOMIC_RELAXED);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------COPY THE LATENCY HISTOGRAM OF ONE FUNCTION------------*/
+status_t list_latency_get(const stats_function_t function, latency_t *latency)
+{
+    if(!latency || function < 0 || function >= STAT_FUNCTIONS)
+        return (INVALID_DATA);
+
+#ifdef GENLIST_LATENCY
+    const long unsigned int *counters = (const long unsigned int*) &genlist_latency[function];
+    long unsigned int *copy = (long unsigned int*) latency;
+    for(len_t i = 0; i < sizeof(latency_t) / sizeof(long unsigned int); i++)
+        copy[i] = __atomic_load_n(&counters[i], __ATOMIC_RELAXED);
+    return (SUCCESS);
+#else
+    memset(latency, 0, sizeof(latency_t));
+    return (LIST_UNSUPPORTED);
+#endif
+}
+
+
+
+/*------------MONOTONIC CLOCK IN NANOSECONDS------------*/
+long unsigned int stats_clock(void)
+{
+#ifdef _WIN32
+    /* no clock_gettime() in the mingw.org runtime. */
+    LARGE_INTEGER now, frequency;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&frequency);
+
+    unsigned long long ticks = (unsigned long long)now.QuadPart, rate = (unsigned long long)frequency.QuadPart;
+    return (long unsigned int)((ticks / rate) * 1000000000ULL + (ticks % rate) * 1000000000ULL / rate);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (long unsigned int)now.tv_sec * 1000000000UL + (long unsigned int)now.tv_nsec;
+#endif
+}
+
+
+
+/*------------END OF A TIMED CALL: ONE MORE CALL IN THE BUCKET OF ITS DURATION------------*/
+void latency_end(struct Latency_Timer *timer)
+{
+    long unsigned int elapsed = stats_clock() - timer->start;
+    latency_t *latency = &genlist_latency[timer->function];
+
+    unsigned int bucket = 0;
+    while(bucket < LATENCY_BUCKETS - 1 && (elapsed >> (bucket + 1)) != 0)
+        bucket++;
+
+    __atomic_fetch_add(&latency->calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&latency->total_ns, elapsed, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&latency->buckets[bucket], 1, __ATOMIC_RELAXED);
+}
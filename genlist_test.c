@@ -0,0 +1,451 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "genlist.h"
+#ifdef GENLIST_PERSIST
+#include <sys/mman.h>
+#endif
+
+
+/*Checks: every group builds lists, runs one feature and compares the result with what it must be.
+A wrong result prints the file line of the check which failed. The exit status is non-zero when any check failed.*/
+
+
+
+/*------------CHECK ONE CONDITION, COUNT THE FAILURES------------*/
+static int failures;
+
+#define CHECK(condition) \
+    ((condition) ? (void)0 : (void)(failures++, fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition)))
+
+
+
+/*------------THE LIST HOLDS EXACTLY THESE INTEGER VALUES, READ FORWARD AND BACKWARD------------*/
+static bool_t holds_ints(const list_t *list, const int *values, const len_t count)
+{
+    if(get_list_length(list) != count)
+        return (false);
+
+    const node_t *current = list->head.next;
+    for(len_t i = 0; i < count; i++, current = current->next) {
+        if(current == &list->head || current->type != INTEGER || current->int_value != values[i])
+            return (false);
+    }
+    if(current != &list->head)
+        return (false);
+
+    current = list->head.prev;
+    for(len_t i = count; i > 0; i--, current = current->prev) {
+        if(current->int_value != values[i - 1] || current->next->prev != current)
+            return (false);
+    }
+
+    return (current == &list->head);
+}
+
+
+
+/*------------POP THE WHOLE LIST FROM THE FRONT, ANY BACKEND: THESE INTEGER VALUES------------*/
+static bool_t drains_ints(list_t *list, const int *values, const len_t count)
+{
+    if(get_list_length(list) != count)
+        return (false);
+
+    view_t view;
+    for(len_t i = 0; i < count; i++) {
+        if(peek_front(list, &view) != SUCCESS || view.type != INTEGER || *(const int*)view.data != values[i])
+            return (false);
+        pop_front(list);
+    }
+
+    return (isEmpty(list) == TRUE);
+}
+
+
+
+/*------------SPLICE AND SPLIT------------*/
+static void check_splice_split(void)
+{
+    int expected[40];
+    list_t *a = create_list(), *b = create_list();
+    for(int i = 0; i < 10; i++) {
+        put_back_int(a, i);
+        put_back_int(b, 100 + i);
+    }
+
+    /* b goes before the 5 of a, and is left empty but usable. */
+    int five = 5;
+    CHECK(list_splice(a, search_node(a, &five, INTEGER), b) == SUCCESS);
+    for(int i = 0; i < 20; i++)
+        expected[i] = i < 5 ? i : i < 15 ? 100 + i - 5 : i - 10;
+    CHECK(holds_ints(a, expected, 20));
+    CHECK(isEmpty(b) == TRUE);
+    CHECK(put_back_int(b, 7) == SUCCESS && holds_ints(b, (const int[]){ 7 }, 1));
+
+    /* at the end, and a list spliced into itself is refused. */
+    CHECK(list_splice(a, NULL, b) == SUCCESS);
+    expected[20] = 7;
+    CHECK(holds_ints(a, expected, 21));
+    CHECK(list_splice(a, NULL, a) == INVALID_DATA);
+
+    /* split at the first 100: the part keeps it and what follows. */
+    int hundred = 100;
+    list_t *part = list_split_at(a, search_node(a, &hundred, INTEGER));
+    CHECK(part != NULL);
+    CHECK(holds_ints(a, expected, 5));
+    if(part)
+        CHECK(holds_ints(part, expected + 5, 16));
+
+    /* split at the first node: the list is left empty. */
+    list_t *whole = part ? list_split_at(part, part->head.next) : NULL;
+    CHECK(whole != NULL && isEmpty(part) == TRUE);
+    if(whole)
+        CHECK(holds_ints(whole, expected + 5, 16));
+
+    /* unrolled and packed lists are joined at the end only. */
+    for(backend_t backend = UNROLLED_LIST; backend <= PACKED_LIST; backend++) {
+        list_t *front = create_list_as(backend), *back = create_list_as(backend);
+        for(int i = 0; i < 20; i++) {
+            put_back_int(i < 12 ? front : back, i);
+            expected[i] = i;
+        }
+
+        CHECK(list_concat(front, back) == SUCCESS);
+        CHECK(isEmpty(back) == TRUE);
+        CHECK(drains_ints(front, expected, 20));
+
+        destroy_list(front);
+        destroy_list(back);
+    }
+
+    destroy_list(a);
+    destroy_list(b);
+    destroy_list(part);
+    destroy_list(whole);
+}
+
+
+
+/*------------SORT: ORDER AND STABILITY------------*/
+struct Record {
+    int key;
+    int sequence;                       // insertion order, must stay increasing among equal keys.
+};
+
+static int compare_keys(const void *first, const void *second)
+{
+    const struct Record *a = (const struct Record*) first, *b = (const struct Record*) second;
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+static void check_sort(void)
+{
+    enum { RECORDS = 5000 };
+    static struct Record records[RECORDS];
+
+    list_t *list = create_list();
+    set_list_structure(list, sizeof(struct Record), compare_keys);
+
+    /* few keys, so most records have equal ones; the order of insertion is their sequence. */
+    srand(7);
+    for(int i = 0; i < RECORDS; i++) {
+        records[i].key = rand() % 50;
+        records[i].sequence = i;
+        put_back(list, &records[i], STRUCTURE);
+    }
+
+    CHECK(sort_list(list, compare_keys) == SUCCESS);
+    CHECK(get_list_length(list) == RECORDS);
+
+    len_t count = 0;
+    bool_t sorted = true, stable = true, linked = true;
+    const struct Record *last = NULL;
+    for(const node_t *current = list->head.next; current != &list->head; current = current->next, count++) {
+        const struct Record *record = (const struct Record*) current->data;
+        if(last && last->key > record->key)
+            sorted = false;
+        if(last && last->key == record->key && last->sequence > record->sequence)
+            stable = false;
+        if(current->next->prev != current)
+            linked = false;
+        last = record;
+    }
+    CHECK(sorted);
+    CHECK(stable);
+    CHECK(linked);
+    CHECK(count == RECORDS);
+    destroy_list(list);
+
+    /* mixed types: INTEGER < DOUBLE < CHARACTER < STRING, then by value. */
+    list = create_list();
+    put_back(list, "pear", STRING);
+    put_back_char(list, 'b');
+    put_back_double(list, 2.5);
+    put_back_int(list, 9);
+    put_back(list, "apple", STRING);
+    put_back_int(list, -3);
+    put_back_double(list, -1.5);
+    put_back_char(list, 'a');
+
+    CHECK(sort_list(list, NULL) == SUCCESS);
+    const node_t *node = list->head.next;
+    CHECK(node->type == INTEGER && node->int_value == -3);
+    node = node->next;
+    CHECK(node->type == INTEGER && node->int_value == 9);
+    node = node->next;
+    CHECK(node->type == DOUBLE && node->double_value == -1.5);
+    node = node->next;
+    CHECK(node->type == DOUBLE && node->double_value == 2.5);
+    node = node->next;
+    CHECK(node->type == CHARACTER && node->char_value == 'a');
+    node = node->next;
+    CHECK(node->type == CHARACTER && node->char_value == 'b');
+    node = node->next;
+    CHECK(node->type == STRING && strcmp((const char*)node->data, "apple") == 0);
+    node = node->next;
+    CHECK(node->type == STRING && strcmp((const char*)node->data, "pear") == 0);
+    CHECK(node->next == &list->head);
+
+    destroy_list(list);
+}
+
+
+
+/*------------COMPACTION: SAME VALUES, SAME ORDER, INDEX STILL RIGHT------------*/
+static void check_compaction(void)
+{
+    enum { VALUES = 20000 };
+    static int expected[VALUES];
+
+    /* churn: every value, then every even value removed and put back at the front. */
+    list_t *list = create_list();
+    for(int i = 0; i < VALUES; i++)
+        put_back_int(list, i);
+    for(int i = 0; i < VALUES; i += 2)
+        remove_data(list, &i, INTEGER);
+    for(int i = 0; i < VALUES; i += 2)
+        put_front_int(list, i);
+
+    len_t count = 0;
+    for(int i = VALUES - 2; i >= 0; i -= 2)
+        expected[count++] = i;
+    for(int i = 1; i < VALUES; i += 2)
+        expected[count++] = i;
+
+    CHECK(enable_index(list) == SUCCESS);
+    CHECK(list_compact(list) == SUCCESS);
+    CHECK(holds_ints(list, expected, VALUES));
+
+    /* the index follows the moved nodes. */
+    for(int i = 0; i < VALUES; i += 97) {
+        const node_t *found = search_node(list, &i, INTEGER);
+        CHECK(found != NULL && found->int_value == i);
+    }
+
+    /* in steps, with the list changed between them. */
+    status_t status;
+    int steps = 0;
+    while((status = list_compact_step(list, 1000)) == LIST_IN_PROGRESS) {
+        if(steps++ == 3)
+            put_back_int(list, VALUES);
+    }
+    CHECK(status == SUCCESS);
+    CHECK(get_list_length(list) == VALUES + 1);
+    CHECK(list->head.prev->int_value == VALUES);
+    CHECK(pop_back(list) == SUCCESS && holds_ints(list, expected, VALUES));
+
+    int missing = VALUES + 1;
+    CHECK(search_node(list, &missing, INTEGER) == NULL);
+
+    destroy_list(list);
+}
+
+
+
+/*------------SAVE AND LOAD: EVERY TYPE COMES BACK BIT-EXACT------------*/
+struct Point {
+    int x, y;
+};
+
+static void check_save_load(void)
+{
+    struct Point points[2] = { { 1, 2 }, { -3, 4 } };
+    double minus_zero = -0.0;
+
+    list_t *list = create_list();
+    set_list_structure(list, sizeof(struct Point), NULL);
+    put_back_int(list, 42);
+    put_back_double(list, minus_zero);
+    put_back_double(list, 1e300);
+    put_back_char(list, 'z');
+    put_back(list, "", STRING);
+    put_back(list, "hello, file", STRING);
+    put_back(list, &points[0], STRUCTURE);
+    put_back(list, &points[1], STRUCTURE);
+    put_back_int(list, -1);
+
+    char path[] = "/tmp/genlist_test_XXXXXX";
+    int fd = mkstemp(path);
+    CHECK(fd >= 0);
+    if(fd < 0) {
+        destroy_list(list);
+        return;
+    }
+    CHECK(list_save(list, fd) == SUCCESS);
+
+    /* the loaded elements are appended after what the list holds. */
+    lseek(fd, 0, SEEK_SET);
+    list_t *loaded = create_list();
+    set_list_structure(loaded, sizeof(struct Point), NULL);
+    put_back_int(loaded, 7);
+    CHECK(list_load(loaded, fd) == SUCCESS);
+    CHECK(get_list_length(loaded) == get_list_length(list) + 1);
+    CHECK(pop_front(loaded) == SUCCESS);
+
+    const node_t *saved = list->head.next, *read = loaded->head.next;
+    for(; saved != &list->head && read != &loaded->head; saved = saved->next, read = read->next) {
+        CHECK(saved->type == read->type);
+        switch(saved->type) {
+            case INTEGER:   CHECK(saved->int_value == read->int_value); break;
+            case DOUBLE:    CHECK(memcmp(&saved->double_value, &read->double_value, sizeof(double)) == 0); break;
+            case CHARACTER: CHECK(saved->char_value == read->char_value); break;
+            case STRING:    CHECK(strcmp((const char*)saved->data, (const char*)read->data) == 0); break;
+            default:        CHECK(memcmp(saved->data, read->data, sizeof(struct Point)) == 0); break;
+        }
+        /* the file holds copies. */
+        if(saved->type == STRING || saved->type == STRUCTURE)
+            CHECK(saved->data != read->data);
+    }
+    CHECK(saved == &list->head && read == &loaded->head);
+
+    /* a list with another structure size refuses the file, and is left as it was. */
+    lseek(fd, 0, SEEK_SET);
+    list_t *other = create_list();
+    set_list_structure(other, sizeof(struct Point) + 4, NULL);
+    CHECK(list_load(other, fd) == INVALID_TYPE);
+    CHECK(isEmpty(other) == TRUE);
+
+    /* a truncated file is refused too. */
+    CHECK(ftruncate(fd, 20) == 0);
+    lseek(fd, 0, SEEK_SET);
+    CHECK(list_load(other, fd) == INVALID_DATA);
+    CHECK(isEmpty(other) == TRUE);
+
+    close(fd);
+    unlink(path);
+    destroy_list(list);
+    destroy_list(loaded);
+    destroy_list(other);
+}
+
+
+
+#ifdef GENLIST_PERSIST
+/*------------PERSISTENT LIST: WHAT WAS PUT IS THERE AFTER REOPENING, ALSO AFTER A CRASH------------*/
+static bool_t plist_holds_ints(plist_t *list, const int *values, const len_t count)
+{
+    if(plist_length(list) != count)
+        return (false);
+
+    /* read the front, move it to the back: after a full turn the list is as it was. */
+    node_t node;
+    for(len_t i = 0; i < count; i++) {
+        if(plist_get_front(list, &node) != SUCCESS || node.type != INTEGER || node.int_value != values[i])
+            return (false);
+        plist_pop_front(list);
+        plist_put_back_int(list, values[i]);
+    }
+
+    return (true);
+}
+
+static void check_persist(void)
+{
+    enum { VALUES = 5000 };
+    static int expected[VALUES + 1];
+
+    char path[] = "/tmp/genlist_test_XXXXXX";
+    int fd = mkstemp(path);
+    CHECK(fd >= 0);
+    if(fd < 0)
+        return;
+    close(fd);
+    unlink(path);
+
+    /* more values than the first 64 KB of the file hold: it has to grow. */
+    plist_t *list = open_plist(path, 0, NULL);
+    CHECK(list != NULL);
+    if(!list)
+        return;
+    for(int i = 0; i < VALUES; i++) {
+        CHECK(plist_put_back_int(list, i) == SUCCESS);
+        expected[i] = i;
+    }
+    CHECK(plist_put_back(list, "persistent", STRING) == SUCCESS);
+    list = close_plist(list);
+
+    list = open_plist(path, 0, NULL);
+    CHECK(list != NULL);
+    if(!list)
+        return;
+    CHECK(plist_length(list) == VALUES + 1);
+    CHECK(plist_contains(list, "persistent", STRING) == TRUE);
+    CHECK(plist_remove_data(list, "persistent", STRING) == SUCCESS);
+    CHECK(plist_holds_ints(list, expected, VALUES));
+
+    /* after / before: -1 goes next to 10 or 11, and is popped through its neighbour. */
+    int ten = 10, eleven = 11, minus_one = -1;
+    CHECK(plist_put_after(list, &ten, INTEGER, &minus_one, INTEGER) == SUCCESS);
+    CHECK(plist_pop_after(list, &ten, INTEGER) == SUCCESS);
+    CHECK(plist_put_before(list, &eleven, INTEGER, &minus_one, INTEGER) == SUCCESS);
+    CHECK(plist_pop_before(list, &eleven, INTEGER) == SUCCESS);
+    CHECK(plist_holds_ints(list, expected, VALUES));
+    int last = VALUES - 1;
+    CHECK(plist_pop_after(list, &last, INTEGER) == FAILED);
+    CHECK(plist_pop_before(list, &expected[0], INTEGER) == FAILED);
+    CHECK(plist_pop_after(list, &minus_one, INTEGER) == LIST_DATA_NOT_FOUND);
+
+    /* a crash: the mapping goes without close_plist(), and the prev links and length are stale. */
+    CHECK(plist_sync(list) == SUCCESS);
+    struct Persistent_Header *header = (struct Persistent_Header*) list->base;
+    header->length = 1;
+    header->head.prev = header->head.next;
+    munmap(list->base, list->mapped);
+    close(list->fd);
+    free(list);
+
+    list = open_plist(path, 0, NULL);
+    CHECK(list != NULL);
+    if(!list)
+        return;
+    CHECK(plist_holds_ints(list, expected, VALUES));
+    CHECK(plist_pop_back(list) == SUCCESS);
+    node_t back;
+    CHECK(plist_get_back(list, &back) == SUCCESS && back.int_value == VALUES - 2);
+    list = close_plist(list);
+
+    unlink(path);
+}
+#endif
+
+
+
+int main(void) {
+
+    check_splice_split();
+    check_sort();
+    check_compaction();
+    check_save_load();
+#ifdef GENLIST_PERSIST
+    check_persist();
+#endif
+
+    if(failures) {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return (EXIT_FAILURE);
+    }
+
+    puts("all checks passed");
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,571 @@
+#include "genlist.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+
+
+/*------------BLOCKS EMPTIER THAN THIS ARE MERGED WITH THEIR NEIGHBOUR------------*/
+#define UNROLLED_MERGE_BELOW    (UNROLLED_BLOCK_SIZE / 4)
+#define UNROLLED_MERGE_LIMIT    (UNROLLED_BLOCK_SIZE * 3 / 4)
+
+
+
+/*------------ALLOCATE ONE EMPTY BLOCK------------*/
+static block_t* create_block(void)
+{
+    block_t *block = (block_t*) xmalloc(sizeof(block_t));
+    if(!block)
+        return (NULL);
+
+    block->count = 0;
+    block->next = block->prev = NULL;
+
+    return (block);
+}
+
+
+
+/*------------LINK 'block' AFTER 'start' (NULL: as first block)------------*/
+static void link_block(list_t *list, block_t *start, block_t *block)
+{
+    block->prev = start;
+    block->next = start ? start->next : list->first_block;
+
+    if(block->next)
+        block->next->prev = block;
+    else
+        list->last_block = block;
+
+    if(start)
+        start->next = block;
+    else
+        list->first_block = block;
+}
+
+
+
+/*------------UNLINK AND DEALLOCATE ONE BLOCK------------*/
+static void delete_block(list_t *list, block_t *block)
+{
+    if(block->prev)
+        block->prev->next = block->next;
+    else
+        list->first_block = block->next;
+
+    if(block->next)
+        block->next->prev = block->prev;
+    else
+        list->last_block = block->prev;
+
+    free(block);
+}
+
+
+
+/*------------VIEW ONE ELEMENT AS A NODE (no allocation)------------*/
+static void element_node(const block_t *block, const unsigned int index, node_t *node)
+{
+    node->double_value = block->values[index].double_value;
+    node->type = (type_t)(block->tags[index] & ~UNROLLED_INLINE);
+    node->storage = (block->tags[index] & UNROLLED_INLINE) ? STORE_INLINE : STORE_REFERENCE;
+    node->type_id = 0;
+    node->hash_tag = 0;
+    node->next = node->prev = node;
+}
+
+
+
+/*------------FIND THE FIRST ELEMENT HOLDING THE GIVEN SCALAR (vector kernels)------------*/
+static bool_t find_scalar_value(const list_t *list, const void * data, const type_t type,
+    block_t **found_block, unsigned int *found_index)
+{
+    /* inline values are stored zero-extended to 8 bytes: build the key the same way. */
+    value_t key;
+    memset(&key, 0, sizeof(key));
+    switch(type) {
+        case INTEGER:   memcpy(&key, data, sizeof(int));    break;
+        case DOUBLE:    memcpy(&key, data, sizeof(double)); break;
+        default:        memcpy(&key, data, sizeof(char));   break;
+    }
+
+    node_t element;
+
+    for(block_t *block = list->first_block; block; block = block->next) {
+
+        /* inline elements: tag and value bytes compared by the kernels. */
+        unsigned int hits = match_tags(block, (unsigned char)type | UNROLLED_INLINE);
+        if(hits)
+            hits &= match_values(block, key);
+
+        /* referenced elements of this type before the first inline hit still need a look. */
+        unsigned int references = match_tags(block, (unsigned char)type);
+        if(hits)
+            references &= (hits & -hits) - 1;
+
+        while(references) {
+            unsigned int i = (unsigned int)__builtin_ctz(references);
+            element_node(block, i, &element);
+            if(match_data(list, &element, data, type)) {
+                *found_block = block;
+                *found_index = i;
+                return (true);
+            }
+            references &= references - 1;
+        }
+
+        if(hits) {
+            *found_block = block;
+            *found_index = (unsigned int)__builtin_ctz(hits);
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
+
+
+/*------------FIND THE FIRST ELEMENT HOLDING THE GIVEN DATA------------*/
+static bool_t unrolled_find(const list_t *list, const void * data, const type_t type,
+    block_t **found_block, unsigned int *found_index)
+{
+    if(type == INTEGER || type == DOUBLE || type == CHARACTER)
+        return find_scalar_value(list, data, type, found_block, found_index);
+
+    node_t element;
+
+    for(block_t *block = list->first_block; block; block = block->next) {
+        for(unsigned int i = 0; i < block->count; i++) {
+
+            /* reject other types on the tag alone. */
+            if((block->tags[i] & ~UNROLLED_INLINE) != (unsigned char)type)
+                continue;
+
+            /* same comparison rules as the linked list. */
+            element_node(block, i, &element);
+            if(match_data(list, &element, data, type)) {
+                *found_block = block;
+                *found_index = i;
+                return (true);
+            }
+        }
+    }
+
+    return (false);
+}
+
+
+
+/*------------INSERT ONE ELEMENT AT 'index' OF 'block' (NULL: empty list)------------*/
+static status_t insert_element(list_t *list, block_t *block, unsigned int index,
+    const value_t value, const unsigned char tag)
+{
+    /* empty list: start the first block. */
+    if(!block) {
+        block = create_block();
+        if(!block)
+            return (MEMORY_ERROR);
+        link_block(list, NULL, block);
+        index = 0;
+    }
+
+    if(block->count == UNROLLED_BLOCK_SIZE) {
+        block_t *newBlock = create_block();
+        if(!newBlock)
+            return (MEMORY_ERROR);
+
+        if(index == UNROLLED_BLOCK_SIZE && block == list->last_block) {
+            /* appending at the end: start a new block, keep this one full. */
+            link_block(list, block, newBlock);
+            block = newBlock;
+            index = 0;
+        } else if(index == 0 && block == list->first_block) {
+            /* prepending at the front: start a new block, keep this one full. */
+            link_block(list, NULL, newBlock);
+            block = newBlock;
+        } else {
+            /* split: move the upper half to the new block. */
+            unsigned int keep = UNROLLED_BLOCK_SIZE / 2;
+
+            memcpy(newBlock->values, &block->values[keep], (block->count - keep) * sizeof(value_t));
+            memcpy(newBlock->tags, &block->tags[keep], block->count - keep);
+            newBlock->count = block->count - keep;
+            block->count = keep;
+            link_block(list, block, newBlock);
+
+            if(index > keep) {
+                block = newBlock;
+                index -= keep;
+            }
+        }
+    }
+
+    /* open a gap at 'index' and store the element. */
+    memmove(&block->values[index + 1], &block->values[index], (block->count - index) * sizeof(value_t));
+    memmove(&block->tags[index + 1], &block->tags[index], block->count - index);
+    block->values[index] = value;
+    block->tags[index] = tag;
+    block->count++;
+
+    list->length++;
+    list->stats.inserts++;
+    STATS_GLOBAL(inserts, 1);
+    if(list->length > list->stats.peak_length)
+        list->stats.peak_length = list->length;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------DELETE THE ELEMENT AT 'index' OF 'block'------------*/
+static void delete_element(list_t *list, block_t *block, const unsigned int index)
+{
+    /* close the gap. */
+    memmove(&block->values[index], &block->values[index + 1], (block->count - index - 1) * sizeof(value_t));
+    memmove(&block->tags[index], &block->tags[index + 1], block->count - index - 1);
+    block->count--;
+
+    list->length--;
+    list->stats.removals++;
+    STATS_GLOBAL(removals, 1);
+
+    if(block->count == 0) {
+        delete_block(list, block);
+        return;
+    }
+
+    /* merge a nearly empty block with its next block, if both fit in one. */
+    block_t *next = block->next;
+    if(block->count < UNROLLED_MERGE_BELOW && next && block->count + next->count <= UNROLLED_MERGE_LIMIT) {
+        memcpy(&block->values[block->count], next->values, next->count * sizeof(value_t));
+        memcpy(&block->tags[block->count], next->tags, next->count);
+        block->count += next->count;
+        delete_block(list, next);
+    }
+}
+
+
+
+/*------------POSITION OF THE ELEMENT AFTER / BEFORE ONE ELEMENT------------*/
+static bool_t next_element(block_t **block, unsigned int *index)
+{
+    if(*index + 1 < (*block)->count) {
+        (*index)++;
+        return (true);
+    }
+    if(!(*block)->next)
+        return (false);
+
+    *block = (*block)->next;
+    *index = 0;
+    return (true);
+}
+
+static bool_t prev_element(block_t **block, unsigned int *index)
+{
+    if(*index > 0) {
+        (*index)--;
+        return (true);
+    }
+    if(!(*block)->prev)
+        return (false);
+
+    *block = (*block)->prev;
+    *index = (*block)->count - 1;
+    return (true);
+}
+
+
+
+/*------------COPY ONE ELEMENT INTO A NEW NODE (as get_* does)------------*/
+static status_t fetch_element(const block_t *block, const unsigned int index, node_t **target_node)
+{
+    node_t element;
+    element_node(block, index, &element);
+
+    *target_node = copy_node(&element);
+    if(!(*target_node))
+        return (MEMORY_ERROR);
+
+    return (SUCCESS);
+}
+
+
+
+/*------------INSERT ONE ELEMENT AT THE FRONT / END------------*/
+status_t unrolled_put_front(list_t *list, const value_t value, const unsigned char tag)
+{
+    return insert_element(list, list->first_block, 0, value, tag);
+}
+
+status_t unrolled_put_back(list_t *list, const value_t value, const unsigned char tag)
+{
+    block_t *block = list->last_block;
+    return insert_element(list, block, block ? block->count : 0, value, tag);
+}
+
+
+
+/*------------INSERT ONE ELEMENT AFTER / BEFORE AN EXISTING ELEMENT------------*/
+status_t unrolled_put_after(list_t *list, const void * existing_data, const type_t existing_type,
+    const value_t value, const unsigned char tag)
+{
+    block_t *block;
+    unsigned int index;
+
+    if(!unrolled_find(list, existing_data, existing_type, &block, &index))
+        return (LIST_DATA_NOT_FOUND);
+
+    return insert_element(list, block, index + 1, value, tag);
+}
+
+status_t unrolled_put_before(list_t *list, const void * existing_data, const type_t existing_type,
+    const value_t value, const unsigned char tag)
+{
+    block_t *block;
+    unsigned int index;
+
+    if(!unrolled_find(list, existing_data, existing_type, &block, &index))
+        return (LIST_DATA_NOT_FOUND);
+
+    return insert_element(list, block, index, value, tag);
+}
+
+
+
+/*------------REMOVE THE FIRST / LAST ELEMENT------------*/
+status_t unrolled_pop_front(list_t *list)
+{
+    delete_element(list, list->first_block, 0);
+    return (SUCCESS);
+}
+
+status_t unrolled_pop_back(list_t *list)
+{
+    delete_element(list, list->last_block, list->last_block->count - 1);
+    return (SUCCESS);
+}
+
+
+
+/*------------REMOVE THE ELEMENT AFTER / BEFORE / HOLDING THE GIVEN DATA------------*/
+status_t unrolled_pop_after(list_t *list, const void * existing_data, const type_t existing_type)
+{
+    block_t *block;
+    unsigned int index;
+
+    if(!unrolled_find(list, existing_data, existing_type, &block, &index))
+        return (LIST_DATA_NOT_FOUND);
+    if(!next_element(&block, &index))
+        return (FAILED);
+
+    delete_element(list, block, index);
+    return (SUCCESS);
+}
+
+status_t unrolled_pop_before(list_t *list, const void * existing_data, const type_t existing_type)
+{
+    block_t *block;
+    unsigned int index;
+
+    if(!unrolled_find(list, existing_data, existing_type, &block, &index))
+        return (LIST_DATA_NOT_FOUND);
+    if(!prev_element(&block, &index))
+        return (FAILED);
+
+    delete_element(list, block, index);
+    return (SUCCESS);
+}
+
+status_t unrolled_remove_data(list_t *list, const void * delete_data, const type_t delete_type)
+{
+    block_t *block;
+    unsigned int index;
+
+    if(!unrolled_find(list, delete_data, delete_type, &block, &index))
+        return (LIST_DATA_NOT_FOUND);
+
+    delete_element(list, block, index);
+    return (SUCCESS);
+}
+
+
+
+/*------------FETCH THE FIRST / LAST ELEMENT------------*/
+status_t unrolled_get_front(const list_t *list, node_t **front_node)
+{
+    return fetch_element(list->first_block, 0, front_node);
+}
+
+status_t unrolled_get_back(const list_t *list, node_t **last_node)
+{
+    return fetch_element(list->last_block, list->last_block->count - 1, last_node);
+}
+
+
+
+/*------------FETCH THE ELEMENT AFTER / BEFORE AN EXISTING ELEMENT------------*/
+status_t unrolled_get_after(const list_t *list, const void * existing_data, const type_t existing_type,
+    node_t **target_node)
+{
+    block_t *block;
+    unsigned int index;
+
+    if(!unrolled_find(list, existing_data, existing_type, &block, &index))
+        return (LIST_DATA_NOT_FOUND);
+    if(!next_element(&block, &index))
+        return (FAILED);
+
+    return fetch_element(block, index, target_node);
+}
+
+status_t unrolled_get_before(const list_t *list, const void * existing_data, const type_t existing_type,
+    node_t **target_node)
+{
+    block_t *block;
+    unsigned int index;
+
+    if(!unrolled_find(list, existing_data, existing_type, &block, &index))
+        return (LIST_DATA_NOT_FOUND);
+    if(!prev_element(&block, &index))
+        return (FAILED);
+
+    return fetch_element(block, index, target_node);
+}
+
+
+
+/*------------VIEW ONE ELEMENT (as peek_* does)------------*/
+static status_t view_element(const block_t *block, const unsigned int index, view_t *view)
+{
+    view->type = (type_t)(block->tags[index] & ~UNROLLED_INLINE);
+    view->data = (block->tags[index] & UNROLLED_INLINE) ? (const void*)&block->values[index] : block->values[index].data;
+
+    return (SUCCESS);
+}
+
+
+
+/*------------VIEW THE FIRST / LAST ELEMENT------------*/
+status_t unrolled_peek_front(const list_t *list, view_t *view)
+{
+    return view_element(list->first_block, 0, view);
+}
+
+status_t unrolled_peek_back(const list_t *list, view_t *view)
+{
+    return view_element(list->last_block, list->last_block->count - 1, view);
+}
+
+
+
+/*------------VIEW THE ELEMENT AFTER / BEFORE AN EXISTING ELEMENT------------*/
+status_t unrolled_peek_after(const list_t *list, const void * existing_data, const type_t existing_type,
+    view_t *view)
+{
+    block_t *block;
+    unsigned int index;
+
+    if(!unrolled_find(list, existing_data, existing_type, &block, &index))
+        return (LIST_DATA_NOT_FOUND);
+    if(!next_element(&block, &index))
+        return (FAILED);
+
+    return view_element(block, index, view);
+}
+
+status_t unrolled_peek_before(const list_t *list, const void * existing_data, const type_t existing_type,
+    view_t *view)
+{
+    block_t *block;
+    unsigned int index;
+
+    if(!unrolled_find(list, existing_data, existing_type, &block, &index))
+        return (LIST_DATA_NOT_FOUND);
+    if(!prev_element(&block, &index))
+        return (FAILED);
+
+    return view_element(block, index, view);
+}
+
+
+
+/*------------RENDER ALL ELEMENTS, IN THE FORMAT OF show_list()------------*/
+status_t unrolled_render_list(const list_t *list, out_buffer_t *out, display_t display, format_t format)
+{
+    node_t element;
+    status_t status;
+
+    out_string(out, "[START] <-> ");
+    for(block_t *block = list->first_block; block; block = block->next) {
+        for(unsigned int i = 0; i < block->count; i++) {
+            element_node(block, i, &element);
+
+            status = render_data(out, &element, display, format);
+            if(!(status == SUCCESS))
+                return (status);
+
+            out_string(out, " <-> ");
+        }
+    }
+    out_string(out, "[END]\n");
+
+    return (out->status);
+}
+
+
+
+/*------------SEARCH DATA IN THE ELEMENTS------------*/
+bool_t unrolled_contains(const list_t *list, const void * data, const type_t type)
+{
+    block_t *block;
+    unsigned int index;
+
+    return unrolled_find(list, data, type, &block, &index);
+}
+
+
+
+/*------------APPEND ALL BLOCKS OF 'src' TO 'dst' (src becomes empty)------------*/
+void unrolled_concat(list_t *dst, list_t *src)
+{
+    if(dst->last_block) {
+        dst->last_block->next = src->first_block;
+        src->first_block->prev = dst->last_block;
+    } else {
+        dst->first_block = src->first_block;
+    }
+    dst->last_block = src->last_block;
+
+    dst->length += src->length;
+    dst->stats.inserts += src->length;
+    STATS_GLOBAL(inserts, src->length);
+    if(dst->length > dst->stats.peak_length)
+        dst->stats.peak_length = dst->length;
+
+    src->stats.removals += src->length;
+    STATS_GLOBAL(removals, src->length);
+    src->first_block = src->last_block = NULL;
+    src->length = 0;
+}
+
+
+
+/*------------DEALLOCATE ALL BLOCKS------------*/
+void unrolled_clear(list_t *list)
+{
+    block_t *block = list->first_block;
+
+    while(block) {
+        block_t *next = block->next;
+        list->stats.removals += block->count;
+        STATS_GLOBAL(removals, block->count);
+        free(block);
+        block = next;
+    }
+
+    list->first_block = list->last_block = NULL;
+    list->length = 0;
+}